@@ -780,6 +780,33 @@ $_->meta->make_immutable(
     Class::MOP::Mixin::HasOverloads
 /;
 
+sub make_all_immutable {
+    my %options = ref $_[0] eq 'HASH' ? %{ shift() } : ();
+    my @metas = map { blessed $_ ? $_ : Class::MOP::Class->initialize($_) } @_;
+
+    my ( $file, $line ) = (caller)[ 1 .. 2 ];
+
+    Class::MOP::Method::Generated->_compile_in_batch( sub {
+        $_->make_immutable( file => $file, line => $line, %options )
+            for @metas;
+    } );
+
+    return @metas;
+}
+
+sub warm_all_metaclasses {
+    my %report = ( metaclasses => 0, methods => 0, compiled_methods => 0 );
+
+    my @metas = grep { defined && $_->can('_warm_caches') }
+        get_all_metaclass_instances();
+
+    $_->_warm_methods( \%report ) for @metas;
+    $_->_warm_caches( \%report ) for @metas;
+    $report{metaclasses} = @metas;
+
+    return \%report;
+}
+
 1;
 
 # ABSTRACT: A Meta Object Protocol for Perl 5
@@ -1001,6 +1028,36 @@ returned.
 You should almost certainly be using
 L<C<Moose::Util::find_meta>|Moose::Util/find_meta> instead.
 
+=head3 Class::MOP::make_all_immutable(\%options?, @metaclasses)
+
+This makes each of the given metaclasses immutable, as if by calling
+C<make_immutable> on each of them with C<%options>. Class names can be given
+instead of metaclasses. It returns the metaclasses.
+
+The methods generated for all these classes are compiled together, by a
+few large evals rather than one eval each, which is quicker when many classes
+are made immutable at once. Until they are compiled, each of these methods
+is a stub which compiles them all when it is called. If a method can't be
+compiled, the error is thrown once all the classes have been made immutable.
+
+=head3 Class::MOP::warm_all_metaclasses
+
+Metaclasses fill some of their caches on first use, such as the method
+objects returned by C<get_method>, the lists returned by C<get_all_methods>
+and C<get_all_attributes>, the meta instance, and the roles a class does.
+Methods with modifiers are only compiled when first called, and with the
+C<MOOSE_LAZY_ACCESSORS> environment variable set, so are accessors (see
+L<Class::MOP::Method::Generated>).
+
+This function fills all of these caches and compiles all of these methods
+for every metaclass, so that a process which forks workers can do it once
+beforehand, rather than each worker doing it and so writing to memory it
+would otherwise share with the others.
+
+It returns a hash reference which counts what it did: the number of
+C<metaclasses> it went through, the number of method objects it made
+(C<methods>), and the number of methods it compiled (C<compiled_methods>).
+
 =head2 Metaclass cache functions
 
 C<Class::MOP> holds a cache of metaclasses. The following are functions
@@ -12,7 +12,7 @@ use Class::MOP::MiniTrait;
 
 use Carp 'confess';
 use Module::Runtime 'use_package_optimistically';
-use Scalar::Util 'blessed';
+use Scalar::Util 'blessed', 'refaddr', 'weaken';
 use Sub::Util 1.40 'set_subname';
 use Try::Tiny;
 use List::Util 1.33 'all';
@@ -921,21 +921,66 @@ sub remove_attribute {
 sub find_attribute_by_name {
     my ( $self, $attr_name ) = @_;
 
-    foreach my $class ( $self->linearized_isa ) {
-        # fetch the meta-class ...
-        my $meta = Class::MOP::Class->initialize($class);
-        return $meta->get_attribute($attr_name)
-            if $meta->has_attribute($attr_name);
-    }
-
-    return;
+    return $self->_all_attribute_map->{$attr_name};
 }
 
 sub get_all_attributes {
     my $self = shift;
-    my %attrs = map { %{ Class::MOP::Class->initialize($_)->_attribute_map } }
-        reverse $self->linearized_isa;
-    return values %attrs;
+    return values %{ $self->_all_attribute_map };
+}
+
+# the attributes of the class and its superclasses by name, with those of
+# subclasses taking precedence
+sub _all_attribute_map {
+    my $self = shift;
+
+    return $self->_cached_over_classes(
+        all_attributes => [ $self->linearized_isa ],
+        sub {
+            return {
+                map { %{ Class::MOP::Class->initialize($_)->_attribute_map } }
+                    reverse @_
+            };
+        },
+    );
+}
+
+# Results computed from the metaclasses of a list of classes are kept until
+# one of those classes gets a new metaclass, or its attributes change, or
+# its package generation (which counts changes to its subs and @ISA) does.
+# The metaclasses are held weakly and compared by identity, as the address
+# of one which went away can be reused by the next.
+sub _cached_over_classes {
+    my ( $self, $name, $classes, $build ) = @_;
+
+    my @metas = map {
+        Class::MOP::get_metaclass_by_name($_)
+            || Class::MOP::Class->initialize($_)
+    } @{$classes};
+
+    my $key = join ',', map {
+        ( $classes->[$_], $metas[$_]{_attribute_map_version} || 0,
+            mro::get_pkg_gen( $classes->[$_] ) );
+    } 0 .. $#metas;
+
+    my $entry = $self->{_cached_over_classes}{$name};
+    return $entry->{value}
+        if $entry
+        && $entry->{key} eq $key
+        && !grep {
+            !$entry->{metas}[$_]
+                || refaddr( $entry->{metas}[$_] ) != refaddr( $metas[$_] )
+        } 0 .. $#metas;
+
+    my $value = $build->( @{$classes} );
+    $self->{_cached_over_classes}{$name} = $entry = {
+        key   => $key,
+        metas => \@metas,
+        value => $value,
+    };
+    weaken($_) for @{ $entry->{metas} };
+
+    return $value;
 }
 
 # Inheritance
@@ -1139,14 +1184,20 @@ sub find_method_by_name {
 sub get_all_methods {
     my $self = shift;
 
-    my %methods;
-    for my $class ( reverse $self->_method_lookup_order ) {
-        my $meta = Class::MOP::Class->initialize($class);
+    my $methods = $self->_cached_over_classes(
+        all_methods => [ $self->_method_lookup_order ],
+        sub {
+            my %methods;
+            for my $class ( reverse @_ ) {
+                my $meta = Class::MOP::Class->initialize($class);
 
-        $methods{ $_->name } = $_ for $meta->_get_local_methods;
-    }
+                $methods{ $_->name } = $_ for $meta->_get_local_methods;
+            }
+            return [ values %methods ];
+        },
+    );
 
-    return values %methods;
+    return @{$methods};
 }
 
 sub get_all_method_names {
@@ -1158,17 +1209,24 @@ sub find_all_methods_by_name {
     my ($self, $method_name) = @_;
     (defined $method_name && length $method_name)
         || $self->_throw_exception( MethodNameNotGiven => class_name => $self->name );
-    my @methods;
-    foreach my $class ($self->_method_lookup_order) {
-        # fetch the meta-class ...
-        my $meta = Class::MOP::Class->initialize($class);
-        push @methods => {
-            name  => $method_name,
-            class => $class,
-            code  => $meta->get_method($method_name)
-        } if $meta->has_method($method_name);
-    }
-    return @methods;
+    my $methods_by_name = $self->_cached_over_classes(
+        methods_by_name => [ $self->_method_lookup_order ],
+        sub { {} },
+    );
+
+    my $methods = $methods_by_name->{$method_name} ||= [
+        map {
+            my $meta = Class::MOP::Class->initialize($_);
+            $meta->has_method($method_name)
+                ? { name  => $method_name,
+                    class => $_,
+                    code  => $meta->get_method($method_name) }
+                : ()
+        } $self->_method_lookup_order
+    ];
+
+    # callers get their own copies to change
+    return map { +{ %{$_} } } @{$methods};
 }
 
 sub find_next_method_by_name {
@@ -1264,6 +1322,19 @@ sub is_pristine {
     return 1;
 }
 
+sub _warm_caches {
+    my ( $self, $report ) = @_;
+
+    $self->SUPER::_warm_caches($report);
+
+    $self->$_ for qw(
+        linearized_isa class_precedence_list get_all_attributes
+        get_all_methods get_all_method_names get_meta_instance
+    );
+
+    return;
+}
+
 ## Class closing
 
 sub is_mutable   { 1 }
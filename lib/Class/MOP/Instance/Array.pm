@@ -0,0 +1,250 @@
+package Class::MOP::Instance::Array;
+our $VERSION = '2.4001';
+
+use strict;
+use warnings;
+
+use List::Util 'max';
+use Scalar::Util 'isweak', 'weaken';
+
+use parent 'Class::MOP::Instance';
+
+# the mop slot always comes first, so no real slot can be at index 0
+my $MOP_SLOT_INDEX = 0;
+
+sub new {
+    my $class = shift;
+    my $self  = $class->SUPER::new(@_);
+
+    $self->{'slot_index_map'} = $self->_build_slot_index_map;
+
+    return $self;
+}
+
+# Instances of a class are also instances of its superclasses, so the code
+# inlined in those has to find its slots at the same place in ours. We start
+# from the superclasses' layouts and append the remaining slots in the order
+# their attributes were added, which keeps the indices of existing slots
+# stable when a class gains attributes.
+sub _build_slot_index_map {
+    my $self = shift;
+
+    my $meta = $self->associated_metaclass;
+
+    my %index_of;
+    my %slot_at;
+
+    for my $superclass ( $meta->superclasses ) {
+        my $super_meta = Class::MOP::class_of($superclass)
+            or next;
+        my $super_instance = $super_meta->get_meta_instance;
+
+        next unless $super_instance->get_all_slots;
+
+        $self->_throw_exception(
+            IncompatibleInstanceLayout => class_name      => $meta->name,
+                                          superclass_name => $superclass,
+        ) unless $super_instance->isa(__PACKAGE__);
+
+        my $super_map = $super_instance->{'slot_index_map'};
+        for my $slot ( keys %{$super_map} ) {
+            my $index = $super_map->{$slot};
+
+            if ( exists $index_of{$slot} ? $index_of{$slot} != $index
+                   : exists $slot_at{$index} ) {
+                $self->_throw_exception(
+                    IncompatibleInstanceLayout => class_name      => $meta->name,
+                                                  superclass_name => $superclass,
+                                                  slot_name       => $slot,
+                );
+            }
+
+            $index_of{$slot} = $index;
+            $slot_at{$index} = $slot;
+        }
+    }
+
+    my $next = 1 + max( $MOP_SLOT_INDEX, keys %slot_at );
+
+    my @attrs = sort {
+               ( $a->insertion_order || 0 ) <=> ( $b->insertion_order || 0 )
+            || $a->name cmp $b->name
+    } $self->get_all_attributes;
+
+    for my $slot ( map { $_->slots } @attrs ) {
+        $index_of{$slot} = $next++
+            unless exists $index_of{$slot};
+    }
+
+    return \%index_of;
+}
+
+sub get_slot_index_map { $_[0]->{'slot_index_map'} }
+
+sub get_slot_index {
+    my ( $self, $slot_name ) = @_;
+
+    my $index = $self->{'slot_index_map'}->{$slot_name};
+    return $index if defined $index;
+
+    $self->_throw_exception(
+        SlotNotInInstanceLayout => class_name => $self->_class_name,
+                                   slot_name  => $slot_name,
+    );
+}
+
+sub create_instance {
+    my $self = shift;
+    bless [], $self->_class_name;
+}
+
+# operations on meta instance
+
+sub is_dependent_on_superclasses { 1 }
+
+# operations on created instances
+
+sub get_slot_value {
+    my ($self, $instance, $slot_name) = @_;
+    $instance->[ $self->get_slot_index($slot_name) ];
+}
+
+sub set_slot_value {
+    my ($self, $instance, $slot_name, $value) = @_;
+    $instance->[ $self->get_slot_index($slot_name) ] = $value;
+}
+
+sub deinitialize_slot {
+    my ( $self, $instance, $slot_name ) = @_;
+    delete $instance->[ $self->get_slot_index($slot_name) ];
+}
+
+sub is_slot_initialized {
+    my ($self, $instance, $slot_name) = @_;
+    exists $instance->[ $self->get_slot_index($slot_name) ];
+}
+
+sub weaken_slot_value {
+    my ($self, $instance, $slot_name) = @_;
+    weaken $instance->[ $self->get_slot_index($slot_name) ];
+}
+
+sub slot_value_is_weak {
+    my ($self, $instance, $slot_name) = @_;
+    isweak $instance->[ $self->get_slot_index($slot_name) ];
+}
+
+sub _get_mop_slot {
+    my ($self, $instance) = @_;
+    $instance->[$MOP_SLOT_INDEX];
+}
+
+sub _has_mop_slot {
+    my ($self, $instance) = @_;
+    exists $instance->[$MOP_SLOT_INDEX];
+}
+
+sub _set_mop_slot {
+    my ($self, $instance, $value) = @_;
+    $instance->[$MOP_SLOT_INDEX] = $value;
+}
+
+sub _clear_mop_slot {
+    my ($self, $instance) = @_;
+    delete $instance->[$MOP_SLOT_INDEX];
+}
+
+# inlinable operation snippets
+
+sub inline_create_instance {
+    my ($self, $class_variable) = @_;
+    'bless [] => ' . $class_variable;
+}
+
+sub inline_slot_access {
+    my ($self, $instance, $slot_name) = @_;
+    sprintf q[%s->[%d]], $instance, $self->get_slot_index($slot_name);
+}
+
+sub _inline_get_mop_slot {
+    my ($self, $instance) = @_;
+    sprintf q[%s->[%d]], $instance, $MOP_SLOT_INDEX;
+}
+
+sub _inline_set_mop_slot {
+    my ($self, $instance, $value) = @_;
+    $self->_inline_get_mop_slot($instance) . " = $value";
+}
+
+sub _inline_clear_mop_slot {
+    my ($self, $instance) = @_;
+    'delete ' . $self->_inline_get_mop_slot($instance);
+}
+
+1;
+
+# ABSTRACT: Instance Meta Object for objects stored in arrays
+
+__END__
+
+=pod
+
+=head1 SYNOPSIS
+
+  package Point;
+
+  use metaclass 'Class::MOP::Class' => (
+      instance_metaclass => 'Class::MOP::Instance::Array',
+  );
+
+  Point->meta->add_attribute( x => ( accessor => 'x' ) );
+  Point->meta->add_attribute( y => ( accessor => 'y' ) );
+
+  # bless [ undef, 1, 2 ], 'Point'
+  my $point = Point->meta->new_object( x => 1, y => 2 );
+
+=head1 DESCRIPTION
+
+This meta-instance stores objects as blessed array references rather than
+hash references. Each slot is given a fixed index in the array, so inlined
+accessors and constructors access it with a constant index, as in
+C<< $_[0]->[2] >>. Array based objects use noticeably less memory than hash
+based ones, particularly for classes with many attributes.
+
+The layout of a class starts with the layouts of its superclasses, so code
+inlined for a superclass works on instances of its subclasses. This means
+that every superclass which has attributes must also store its instances in
+arrays. A class which inherits from several such classes can only be laid out
+if their layouts don't overlap, which in practice means only one of them can
+have attributes. An exception is thrown otherwise.
+
+Index 0 is reserved for the internal slot used by anonymous classes. Other
+indices are assigned in the order attributes were added to the class, so
+adding an attribute to a class doesn't move existing slots. Removing or
+adding attributes in a superclass which already has subclasses does, though,
+so such classes should be finished (and ideally made immutable) before
+creating any instances.
+
+=head1 INHERITANCE
+
+C<Class::MOP::Instance::Array> is a subclass of L<Class::MOP::Instance>.
+
+=head1 METHODS
+
+This class provides array based versions of all the L<Class::MOP::Instance>
+methods, along with the following:
+
+=over 4
+
+=item B<< $metainstance->get_slot_index($slot_name) >>
+
+Returns the index of the slot in the instance array. This throws an
+exception if the slot isn't part of the class's layout.
+
+=item B<< $metainstance->get_slot_index_map >>
+
+Returns a hash reference mapping each slot name to its index.
+
+=back
+
+=cut
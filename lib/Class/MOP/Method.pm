@@ -4,7 +4,8 @@ our $VERSION = '2.4001';
 use strict;
 use warnings;
 
-use Scalar::Util 'weaken', 'reftype', 'blessed';
+use Scalar::Util 'weaken', 'reftype', 'blessed', 'refaddr';
+use Sub::Util 1.40 'set_subname';
 
 use parent 'Class::MOP::Object';
 
@@ -143,6 +144,37 @@ sub clone {
     return $clone;
 }
 
+# puts $new in the place of $old as the body of the method, and in the
+# package it was installed in. $new gets the name of $old unless it has one.
+sub _replace_body {
+    my ( $self, $old, $new ) = @_;
+
+    return unless $self->{body} && refaddr( $self->{body} ) == refaddr($old);
+
+    my ( $package, $name ) = Class::MOP::get_code_info($old);
+    set_subname( $package . '::' . $name, $new )
+        unless $name =~ /^__ANON__/
+        || ( Class::MOP::get_code_info($new) )[1] !~ /^__ANON__/;
+
+    $self->{body} = $new;
+
+    # the class may be immutable by now
+    my $meta = $self->associated_metaclass
+        or return;
+    my $stash = $meta->_package_stash;
+    my $installed = $stash->get_symbol( '&' . $self->name );
+    return unless $installed && refaddr($installed) == refaddr($old);
+
+    # the method map is still right afterwards if it was before
+    my $in_sync = defined $meta->{_package_cache_flag}
+        && $meta->{_package_cache_flag}
+        == Class::MOP::check_package_cache_flag( $meta->name );
+
+    $stash->add_symbol( '&' . $self->name, $new );
+
+    $meta->update_package_cache_flag if $in_sync;
+}
+
 sub _inline_throw_exception {
     my ( $self, $exception_type, $throw_args ) = @_;
     return
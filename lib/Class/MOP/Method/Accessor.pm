@@ -40,7 +40,7 @@ sub new {
     # needed
     weaken($self->{'attribute'});
 
-    $self->_initialize_body;
+    $self->_initialize_body_lazily;
 
     return $self;
 }
@@ -4,7 +4,9 @@ our $VERSION = '2.4001';
 use strict;
 use warnings;
 
+use Carp 'confess';
 use Eval::Closure;
+use Scalar::Util 'weaken';
 
 use parent 'Class::MOP::Method';
 
@@ -43,6 +45,13 @@ sub _generate_description {
     return "$desc ($origin)";
 }
 
+# While a batch is open (see Class::MOP::make_all_immutable), _compile_code
+# returns a stub rather than compiling the source. The sources of all the
+# stubs are compiled together by a few evals when the batch is finished,
+# or as soon as one of the stubs is called, and each stub is then replaced
+# by its code in the method and the package it was installed in.
+our $_batch;
+
 sub _compile_code {
     my ( $self, @args ) = @_;
     unshift @args, 'source' if @args % 2;
@@ -53,11 +62,195 @@ sub _compile_code {
         ? $self->_eval_environment
         : {};
 
-    return eval_closure(
+    my %closure = (
         environment => $environment,
         description => $self->_generate_description($context),
         %args,
     );
+
+    my $later = $_batch
+        && !grep { !/^(?:source|environment|description)$/ } keys %closure;
+
+    return $later
+        ? $self->_compile_code_later( \%closure )
+        : eval_closure(%closure);
+}
+
+sub _compile_in_batch {
+    my ( $class, $code ) = @_;
+
+    return $code->() if $_batch;
+
+    my $batch = { pending => [], after => [] };
+    {
+        local $_batch = $batch;
+        $code->();
+    }
+
+    _compile_batch($batch);
+
+    my ($error) = grep {defined} map { $_->{error} } @{ $batch->{compiled} };
+    die $error if defined $error;
+
+    return;
+}
+
+sub _compile_code_later {
+    my ( $self, $closure ) = @_;
+
+    my $batch = $_batch;
+    my $entry = { closure => $closure, method => $self };
+    weaken $entry->{method};
+
+    my $stub = sub {
+        _compile_batch($batch) unless $entry->{code} || $entry->{error};
+        die $entry->{error} if defined $entry->{error};
+        goto &{ $entry->{code} };
+    };
+    weaken( $entry->{stub} = $stub );
+
+    push @{ $batch->{pending} }, $entry;
+
+    return $stub;
+}
+
+# runs $code once all the code asked for so far has been compiled
+sub _after_compile {
+    my ( $self, $code ) = @_;
+
+    return $code->() unless $_batch && @{ $_batch->{pending} };
+
+    push @{ $_batch->{after} }, $code;
+}
+
+# perl looks names up in the pad of the sub being compiled one by one, so
+# compiling a batch gets slower than compiling its sources one at a time
+# once it holds a few hundred variables
+my $batch_size = 50;
+
+sub _compile_batch {
+    my $batch = shift;
+
+    while ( my @entries = splice @{ $batch->{pending} }, 0, $batch_size ) {
+        push @{ $batch->{compiled} }, @entries;
+        _compile_entries(@entries);
+    }
+
+    $_->() for splice @{ $batch->{after} };
+
+    return;
+}
+
+sub _compile_entries {
+    my @entries = @_;
+
+    # each source gets the variables of its own environment, copied from
+    # the one lexical which holds all of them
+    my @source = ( 'sub {', '[' );
+    for my $i ( 0 .. $#entries ) {
+        my $closure = $entries[$i]{closure};
+        my $description = $closure->{description};
+        $description =~ s/"/\\"/g;
+
+        push @source, 'do {',
+            (
+            map {
+                'my ' . $_ . ' = ' . substr( $_, 0, 1 )
+                    . '{ $__environments->[' . $i . "]{'" . $_ . "'} };"
+            } sort keys %{ $closure->{environment} }
+            ),
+            qq{#line 1 "$description"},
+            ( ref $closure->{source} ? @{ $closure->{source} } : $closure->{source} ),
+            '},';
+    }
+    push @source, ']', '}';
+
+    my $code = eval {
+        eval_closure(
+            source      => \@source,
+            environment => {
+                '$__environments' =>
+                    \[ map { $_->{closure}{environment} } @entries ],
+            },
+            description => 'batch of generated methods',
+        )->();
+    };
+
+    for my $i ( 0 .. $#entries ) {
+        my $entry = $entries[$i];
+
+        # if the batch couldn't be compiled, each source is compiled by
+        # itself, so that only the broken ones fail, with their own error
+        if ( $code && ref $code->[$i] eq 'CODE' ) {
+            $entry->{code} = $code->[$i];
+        }
+        elsif ( !eval { $entry->{code} = eval_closure( %{ $entry->{closure} } ); 1 } ) {
+            $entry->{error} = $@;
+            next;
+        }
+
+        $entry->{method}->_replace_body( $entry->{stub}, $entry->{code} )
+            if $entry->{method} && $entry->{stub};
+    }
+
+    return;
+}
+
+# With MOOSE_LAZY_ACCESSORS set, accessors and delegations, which call this
+# rather than _initialize_body, only generate and compile their code when
+# they are first called. Until then their body is a stub which does that and
+# then puts the code in its place. The stub only holds a weak reference to
+# the method, which is kept alive by its class and attribute, so dropping the
+# class frees both.
+sub _initialize_body_lazily {
+    my $self = shift;
+
+    # delegations are only attached to their class once they are made
+    my $attr = $self->associated_attribute;
+    my $meta = $attr && $attr->associated_class;
+    return $self->_initialize_body
+        unless $ENV{MOOSE_LAZY_ACCESSORS} && $meta;
+
+    my $state = { method => $self, name => $self->fully_qualified_name };
+    my $stub = sub {
+        goto &{
+            $state->{code}
+                || ( $state->{method}
+                    || confess "The code of $state->{name} can't be generated"
+                    . ' because its method object no longer exists' )
+                ->_finish_lazy_body
+        };
+    };
+    weaken( $state->{method} );
+    weaken( $state->{stub} = $stub );
+
+    $self->{'body'} = $stub;
+    $self->{'_lazy_body'} = $state;
+
+    return;
+}
+
+# compiles the code of a lazy method which hasn't been called yet, and
+# returns it
+sub _finish_lazy_body {
+    my $self = shift;
+
+    my $state = $self->{'_lazy_body'}
+        or return;
+
+    my $code = do {
+        local $self->{'body'};
+        $self->_initialize_body;
+        $self->{'body'};
+    };
+
+    $self->_replace_body( $state->{stub}, $code );
+
+    $state->{code} = $code;
+    delete $state->{method};
+    delete $self->{'_lazy_body'};
+
+    return $code;
 }
 
 1;
@@ -76,4 +269,15 @@ C<Class::MOP::Method::Constructor>.
 
 It is not intended to be used directly.
 
+If the C<MOOSE_LAZY_ACCESSORS> environment variable is true when an
+attribute's accessors and delegations are made, each of them is installed as
+a small stub, and its code is only generated and compiled when it is first
+called, which then replaces the stub. This makes defining classes quicker
+when many of their methods are never called.
+
+Note that this changes when errors in generating the code of a method are
+thrown. Without the variable they are thrown when the method is made, for
+example by C<add_attribute> or C<make_immutable>, but with it they are only
+thrown when the method is first called.
+
 =cut
@@ -4,64 +4,122 @@ our $VERSION = '2.4001';
 use strict;
 use warnings;
 
-use Scalar::Util 'blessed';
+use Eval::Closure;
+use Scalar::Util 'blessed', 'weaken';
 use Sub::Util 1.40 'set_subname';
 
 use parent 'Class::MOP::Method';
 
-# NOTE:
-# this ugly beast is the result of trying
-# to micro optimize this as much as possible
-# while not completely loosing maintainability.
-# At this point it's "fast enough", after all
-# you can't get something for nothing :)
-my $_build_wrapped_method = sub {
+# The wrapped method is compiled into a single sub which calls the before
+# modifiers, the outermost around modifier (or the original method) and the
+# after modifiers in turn. Each around modifier other than the outermost gets
+# called by a closure, which is what the next outer one gets as its $orig.
+#
+# Until it is compiled, the method's body is a dispatcher which compiles it
+# when it is called. The compiled sub then replaces the dispatcher as the
+# body and in the package, so calls after the first go straight to it.
+# Adding a modifier throws the compiled sub away and puts a dispatcher back,
+# so a method which gets several modifiers while its class is being defined
+# is compiled once at most.
+my $_compile_wrapped_method = sub {
     my $modifier_table = shift;
     my ($before, $after, $around) = (
         $modifier_table->{before},
         $modifier_table->{after},
         $modifier_table->{around},
     );
-    if (@$before && @$after) {
-        $modifier_table->{cache} = sub {
-            for my $c (@$before) { $c->(@_) };
-            my @rval;
-            ((defined wantarray) ?
-                ((wantarray) ?
-                    (@rval = $around->{cache}->(@_))
-                    :
-                    ($rval[0] = $around->{cache}->(@_)))
-                :
-                $around->{cache}->(@_));
-            for my $c (@$after) { $c->(@_) };
-            return unless defined wantarray;
-            return wantarray ? @rval : $rval[0];
-        }
-    }
-    elsif (@$before) {
-        $modifier_table->{cache} = sub {
-            for my $c (@$before) { $c->(@_) };
-            return $around->{cache}->(@_);
-        }
+
+    my @arounds = @{ $around->{methods} };
+
+    my @source = ( 'my $next_' . @arounds . ' = $orig;' );
+    for my $i ( reverse 0 .. $#arounds ) {
+        push @source,
+            'my $next_' . $i . ' = Sub::Util::set_subname($name, sub {',
+                '$around[' . $i . ']->($next_' . ( $i + 1 ) . ', @_);',
+            '});';
     }
-    elsif (@$after) {
-        $modifier_table->{cache} = sub {
-            my @rval;
-            ((defined wantarray) ?
-                ((wantarray) ?
-                    (@rval = $around->{cache}->(@_))
-                    :
-                    ($rval[0] = $around->{cache}->(@_)))
-                :
-                $around->{cache}->(@_));
-            for my $c (@$after) { $c->(@_) };
-            return unless defined wantarray;
-            return wantarray ? @rval : $rval[0];
-        }
+    push @source, '$table->{around}{cache} = $next_0;';
+
+    if ( !@$before && !@$after ) {
+        push @source, '$next_0;';
     }
     else {
-        $modifier_table->{cache} = $around->{cache};
+        my $call = @arounds
+            ? '$around[0]->($next_1, @_)'
+            : '$orig->(@_)';
+
+        push @source, (
+            'sub {',
+                ( map { '$before[' . $_ . ']->(@_);' } 0 .. $#{$before} ),
+                ( @$after
+                    ? (
+                        'my @rval;',
+                        'if (wantarray) {',
+                            '@rval = ' . $call . ';',
+                        '}',
+                        'elsif (defined wantarray) {',
+                            '$rval[0] = ' . $call . ';',
+                        '}',
+                        'else {',
+                            $call . ';',
+                        '}',
+                        ( map { '$after[' . $_ . ']->(@_);' } 0 .. $#{$after} ),
+                        'return unless defined wantarray;',
+                        'return wantarray ? @rval : $rval[0];',
+                    )
+                    : 'return ' . $call . ';' ),
+            '};',
+        );
     }
+
+    my $wrapped = eval_closure(
+        source      => \@source,
+        environment => {
+            '$orig'   => \$modifier_table->{orig},
+            '$table'  => \$modifier_table,
+            '$name'   => \$modifier_table->{name},
+            '@before' => $before,
+            '@after'  => $after,
+            '@around' => \@arounds,
+        },
+    );
+
+    return $modifier_table->{cache} = $wrapped
+        if $wrapped == $modifier_table->{orig};
+
+    $modifier_table->{cache} = set_subname( $modifier_table->{name} => $wrapped );
+
+    my $method = $modifier_table->{method};
+    $method->_replace_body( $method->body, $wrapped ) if $method;
+
+    return $wrapped;
+};
+
+my $_dispatch_wrapped_method = sub {
+    my $modifier_table = shift;
+
+    return sub {
+        (      $modifier_table->{cache}
+            || $_compile_wrapped_method->($modifier_table) )->(@_);
+    };
+};
+
+my $_build_wrapped_method = sub {
+    my $modifier_table = shift;
+
+    my $compiled = $modifier_table->{cache};
+    $modifier_table->{cache} = undef;
+    $modifier_table->{around}{cache} = undef;
+
+    my $method = $modifier_table->{method};
+    return unless $compiled && $method && $method->body == $compiled;
+    $method->_replace_body(
+        $compiled,
+        set_subname(
+            $method->fully_qualified_name,
+            $_dispatch_wrapped_method->($modifier_table)
+        ),
+    );
 };
 
 sub wrap {
@@ -73,9 +131,14 @@ sub wrap {
                                                       code   => $code
                           );
 
+    # get these from the original unless explicitly overridden
+    my $pkg_name    = $params{package_name} || $code->package_name;
+    my $method_name = $params{name}         || $code->name;
+
     my $modifier_table = {
         cache  => undef,
         orig   => $code->body,
+        name   => "${pkg_name}::_wrapped_${method_name}",
         before => [],
         after  => [],
         around => {
@@ -85,22 +148,16 @@ sub wrap {
     };
     $_build_wrapped_method->($modifier_table);
 
-    # get these from the original unless explicitly overridden
-    my $pkg_name    = $params{package_name} || $code->package_name;
-    my $method_name = $params{name}         || $code->name;
-
-    return $class->SUPER::wrap(
-        sub {
-            my $wrapped
-                = set_subname( "${pkg_name}::_wrapped_${method_name}" =>
-                    $modifier_table->{cache} );
-            return $wrapped->(@_) ;
-        },
+    my $method = $class->SUPER::wrap(
+        $_dispatch_wrapped_method->($modifier_table),
         package_name    => $pkg_name,
         name            => $method_name,
         original_method => $code,
         modifier_table  => $modifier_table,
     );
+    weaken( $modifier_table->{method} = $method );
+
+    return $method;
 }
 
 sub _new {
@@ -123,6 +180,16 @@ sub _new {
     } => $class;
 }
 
+# compiles the wrapped method if it hasn't been called since its last
+# modifier was added, and returns it
+sub _finish_lazy_body {
+    my $code = shift;
+
+    return if $code->{'modifier_table'}{cache};
+
+    return $_compile_wrapped_method->( $code->{'modifier_table'} );
+}
+
 sub get_original_method {
     my $code = shift;
     $code->original_method;
@@ -152,31 +219,11 @@ sub after_modifiers {
     return @{$code->{'modifier_table'}->{after}};
 }
 
-{
-    # NOTE:
-    # this is another possible candidate for
-    # optimization as well. There is an overhead
-    # associated with the currying that, if
-    # eliminated might make around modifiers
-    # more manageable.
-    my $compile_around_method = sub {{
-        my $f1 = pop;
-        return $f1 unless @_;
-        my $f2 = pop;
-        push @_, sub { $f2->( $f1, @_ ) };
-        redo;
-    }};
-
-    sub add_around_modifier {
-        my $code     = shift;
-        my $modifier = shift;
-        unshift @{$code->{'modifier_table'}->{around}->{methods}} => $modifier;
-        $code->{'modifier_table'}->{around}->{cache} = $compile_around_method->(
-            @{$code->{'modifier_table'}->{around}->{methods}},
-            $code->{'modifier_table'}->{orig}
-        );
-        $_build_wrapped_method->($code->{'modifier_table'});
-    }
+sub add_around_modifier {
+    my $code     = shift;
+    my $modifier = shift;
+    unshift @{$code->{'modifier_table'}->{around}->{methods}} => $modifier;
+    $_build_wrapped_method->($code->{'modifier_table'});
 }
 
 sub around_modifiers {
@@ -30,6 +30,7 @@ sub add_attribute {
     $attribute->_set_insertion_order($order);
 
     $self->_attribute_map->{$attr_name} = $attribute;
+    $self->{_attribute_map_version}++;
 
     # This method is called to allow for installing accessors. Ideally, we'd
     # use method overriding, but then the subclass would be responsible for
@@ -70,6 +71,7 @@ sub remove_attribute {
     return unless defined $removed_attribute;
 
     delete $self->_attribute_map->{$attribute_name};
+    $self->{_attribute_map_version}++;
 
     return $removed_attribute;
 }
@@ -224,6 +224,34 @@ sub _full_method_map {
     return $self->_method_map;
 }
 
+# These make the method objects and compile the methods which are otherwise
+# made on first use, and then fill the caches which are otherwise filled on
+# first use, counting what they did in %$report. The caches are filled once
+# all the methods are done, as compiling a method changes its package (see
+# Class::MOP::warm_all_metaclasses).
+sub _warm_methods {
+    my ( $self, $report ) = @_;
+
+    my $known = keys %{ $self->_method_map };
+    my $map   = $self->_full_method_map;
+    $report->{methods} += keys( %{$map} ) - $known;
+
+    for my $method ( values %{$map} ) {
+        next unless blessed $method && $method->can('_finish_lazy_body');
+        $report->{compiled_methods}++ if $method->_finish_lazy_body;
+    }
+
+    return;
+}
+
+sub _warm_caches {
+    my $self = shift;
+
+    $self->_package_stash;
+
+    return;
+}
+
 1;
 
 # ABSTRACT: Methods for metaclasses which have methods
@@ -33,13 +33,23 @@ sub _build_trace {
 
     # skip frames that are method calls on the exception object, which include
     # the object itself in the arguments (but Devel::LeakTrace really ought to
-    # be weakening all references in its frames)
+    # be weakening all references in its frames), and then the constructor,
+    # unless it is implemented in C and has no frame of its own
     my $skip = 0;
-    while (my @c = caller(++$skip)) {
-        last if ($c[3] =~ /^(.*)::new$/ || $c[3] =~ /^\S+ (.*)::new \(defined at /)
-            && $self->isa($1);
+    {
+        package DB;
+        while ( my @c = caller(++$skip) ) {
+            last unless $c[4]
+                && ref $DB::args[0]
+                && Scalar::Util::refaddr( $DB::args[0] )
+                == Scalar::Util::refaddr($self);
+        }
     }
-    $skip++;
+    my @c = caller($skip);
+    $skip++
+        if @c
+        && ( $c[3] =~ /^(.*)::new$/ || $c[3] =~ /^\S+ (.*)::new \(defined at / )
+        && $self->isa($1);
 
     Devel::StackTrace->new(
         message => $self->message,
@@ -0,0 +1,34 @@
+package Moose::Exception::IncompatibleInstanceLayout;
+our $VERSION = '2.4001';
+
+use Moose;
+extends 'Moose::Exception';
+with 'Moose::Exception::Role::Class';
+
+has 'superclass_name' => (
+    is       => 'ro',
+    isa      => 'Str',
+    required => 1,
+);
+
+has 'slot_name' => (
+    is        => 'ro',
+    isa       => 'Str',
+    predicate => 'has_slot_name',
+);
+
+sub _build_message {
+    my $self            = shift;
+    my $class_name      = $self->class_name;
+    my $superclass_name = $self->superclass_name;
+
+    return "The slot '" . $self->slot_name . "' of $superclass_name cannot be"
+         . " stored at the same array index in instances of $class_name"
+        if $self->has_slot_name;
+
+    return "Instances of $class_name are stored in arrays, so the instances"
+         . " of its superclass $superclass_name must be stored in arrays too";
+}
+
+__PACKAGE__->meta->make_immutable;
+1;
@@ -0,0 +1,38 @@
+package Moose::Exception::InvalidTypeConstraintOptions;
+our $VERSION = '2.4001';
+
+use Moose;
+extends 'Moose::Exception';
+
+has 'function' => (
+    is       => 'ro',
+    isa      => 'Str',
+    required => 1
+);
+
+has 'invalid_options' => (
+    is       => 'ro',
+    traits   => ['Array'],
+    handles  => {
+        _join_invalid_options => 'join',
+    },
+    required => 1,
+);
+
+has 'valid_options' => (
+    is       => 'ro',
+    traits   => ['Array'],
+    handles  => {
+        _join_valid_options => 'join',
+    },
+    required => 1,
+);
+
+sub _build_message {
+    my $self = shift;
+    "Invalid options for ".$self->function." (".$self->_join_invalid_options(', ')
+        ."). The valid options are (".$self->_join_valid_options(', ').")";
+}
+
+__PACKAGE__->meta->make_immutable;
+1;
@@ -0,0 +1,20 @@
+package Moose::Exception::SlotNotInInstanceLayout;
+our $VERSION = '2.4001';
+
+use Moose;
+extends 'Moose::Exception';
+with 'Moose::Exception::Role::Class';
+
+has 'slot_name' => (
+    is       => 'ro',
+    isa      => 'Str',
+    required => 1,
+);
+
+sub _build_message {
+    my $self = shift;
+    "The slot '" . $self->slot_name . "' is not part of the instance layout of " . $self->class_name;
+}
+
+__PACKAGE__->meta->make_immutable;
+1;
@@ -623,7 +623,8 @@ sub _inline_set_value {
 
 sub _writer_value_needs_copy {
     my $self = shift;
-    return $self->should_coerce;
+    return $self->should_coerce
+        || ( $self->has_type_constraint && $self->type_constraint->_interner );
 }
 
 sub _inline_copy_value {
@@ -669,6 +670,9 @@ sub _inline_tc_code {
         $self->_inline_check_constraint(
             $value, $tc, $message, $is_lazy,
         ),
+        ( $self->has_type_constraint
+            ? $self->type_constraint->_inline_intern_value($value)
+            : () ),
     );
 }
 
@@ -769,6 +773,44 @@ sub _inline_trigger {
     return '$trigger->(' . $instance . ', ' . $value . ', ' . $old . ');';
 }
 
+# Whether the C code used by immutable classes can store a value in this
+# attribute's slot with the same effect as the code from _inline_set_value
+# (triggers aside, which writers and constructors deal with separately).
+sub _can_xs_set_value {
+    my $self = shift;
+
+    return 0 if $self->should_coerce || $self->is_weak_ref;
+    return 0 if $self->has_type_constraint && !defined $self->_xs_type_name;
+
+    return 0 unless Moose::Util::_is_unmodified(
+        $self, 'Moose::Meta::Attribute',
+        qw(
+            _inline_set_value _writer_value_needs_copy _inline_check_required
+            _inline_tc_code _inline_check_coercion _inline_check_constraint
+            _inline_weaken_value
+            ),
+    );
+    return 0 unless Moose::Util::_is_unmodified(
+        $self, 'Class::MOP::Attribute',
+        qw( _inline_instance_set slots ),
+    );
+
+    return Moose::Util::_is_unmodified(
+        $self->associated_class->get_meta_instance, 'Class::MOP::Instance',
+        qw( inline_set_slot_value inline_slot_access ),
+    );
+}
+
+# The name of the type constraint the C code should check, if it can check
+# it; see Moose::Meta::TypeConstraint::_xs_type_name.
+sub _xs_type_name {
+    my $self = shift;
+
+    return undef unless $self->has_type_constraint;
+
+    return $self->type_constraint->_xs_type_name;
+}
+
 sub _eval_environment {
     my $self = shift;
 
@@ -913,7 +955,8 @@ sub _inline_init_from_default {
         # appropriate for checking the result of a default
         $self->has_type_constraint
             ? ($self->_inline_check_coercion($default, $tc, $coercion, $for_lazy),
-               $self->_inline_check_constraint($default, $tc, $message, $for_lazy))
+               $self->_inline_check_constraint($default, $tc, $message, $for_lazy),
+               $self->type_constraint->_inline_intern_value($default))
             : (),
         $self->_inline_init_slot($instance, $default),
         $self->_inline_weaken_value($instance, $default),
@@ -1317,6 +1360,10 @@ sub _coerce_and_verify {
 
     $self->verify_against_type_constraint($val, instance => $instance);
 
+    if ( my $interner = $self->type_constraint->_interner ) {
+        $val = $interner->($val);
+    }
+
     return $val;
 }
 
@@ -7,7 +7,7 @@ use warnings;
 use Class::MOP;
 use Data::OptList;
 use List::Util 1.33 qw( any );
-use Scalar::Util 'blessed';
+use Scalar::Util 'blessed', 'refaddr';
 
 use Moose::Meta::Method::Overridden;
 use Moose::Meta::Method::Augmented;
@@ -60,13 +60,19 @@ sub initialize {
     unshift @args, 'package' if @args % 2;
     my %opts = @args;
     my $package = delete $opts{package};
-    return Class::MOP::get_metaclass_by_name($package)
-        || $class->SUPER::initialize($package,
-                'attribute_metaclass' => 'Moose::Meta::Attribute',
-                'method_metaclass'    => 'Moose::Meta::Method',
-                'instance_metaclass'  => 'Moose::Meta::Instance',
-                %opts,
-            );
+    if ( my $meta = Class::MOP::get_metaclass_by_name($package) ) {
+        return $meta;
+    }
+
+    # a class may now have roles where it had none
+    _role_sets_changed();
+
+    return $class->SUPER::initialize($package,
+        'attribute_metaclass' => 'Moose::Meta::Attribute',
+        'method_metaclass'    => 'Moose::Meta::Method',
+        'instance_metaclass'  => 'Moose::Meta::Instance',
+        %opts,
+    );
 }
 
 sub create {
@@ -184,6 +190,7 @@ sub add_role {
                                                                   class_name       => $self->name,
                           );
     push @{$self->roles} => $role;
+    _role_sets_changed();
 }
 
 sub role_applications {
@@ -235,18 +242,50 @@ sub does_role {
     (defined $role_name)
         || throw_exception( RoleNameRequired => class_name => $self->name );
 
-    foreach my $class ($self->class_precedence_list) {
-        my $meta = Class::MOP::class_of($class);
-        # when a Moose metaclass is itself extended with a role,
-        # this check needs to be done since some items in the
-        # class_precedence_list might in fact be Class::MOP
-        # based still.
-        next unless $meta && $meta->can('roles');
-        foreach my $role (@{$meta->roles}) {
-            return 1 if $role->does_role($role_name);
-        }
+    my $name = blessed $role_name ? $role_name->name : $role_name;
+
+    return $self->_role_set->{$name} ? 1 : 0;
+}
+
+# The names of all the roles the class does, kept in C until a role is added
+# anywhere or the methods or @ISA of the class change (see xs/Object.xs).
+# Moose::Object::does answers from the same set, as long as it gives the same
+# answers as does_role would.
+sub _role_set {
+    my $self = shift;
+    my $name = $self->name;
+
+    if ( my $roles = _cached_role_set( $name, $self ) ) {
+        return $roles;
     }
-    return 0;
+
+    my %roles = map { $_->name => 1 } $self->calculate_all_roles_with_inheritance;
+    _cache_role_set(
+        $name, $self, \%roles, $self->is_immutable,
+        $self->_has_standard_does_role,
+    );
+
+    return \%roles;
+}
+
+sub _warm_caches {
+    my ( $self, $report ) = @_;
+
+    $self->SUPER::_warm_caches($report);
+    $self->_role_set;
+
+    return;
+}
+
+sub _has_standard_does_role {
+    my $self = shift;
+
+    if ( $self->is_mutable ) {
+        return $self->can('does_role') == \&does_role;
+    }
+
+    return $self->_get_mutable_metaclass_name->can('does_role') == \&does_role
+        && $self->immutable_trait eq 'Moose::Meta::Class::Immutable::Trait';
 }
 
 sub excludes_role {
@@ -772,10 +811,54 @@ sub _immutable_options {
         # Moose always does this when an attribute is created
         inline_accessors => 0,
 
+        xs_accessors => 1,
+        xs_constructor => 1,
+
         @args,
     );
 }
 
+sub _install_inlined_code {
+    my ( $self, %args ) = @_;
+
+    $self->SUPER::_install_inlined_code(%args);
+    $self->_install_xs_accessors(%args) if $args{xs_accessors};
+}
+
+sub _install_xs_accessors {
+    my $self = shift;
+
+    foreach my $attr ( map { $self->get_attribute($_) } $self->get_attribute_list ) {
+        foreach my $method ( @{ $attr->associated_methods } ) {
+            my $name = $method->name;
+
+            # if the accessor has been wrapped by a method modifier or
+            # replaced since it was installed, we leave it alone
+            my $current = $self->_get_maybe_raw_method($name);
+            next unless $current && refaddr($current) == refaddr($method);
+            next unless $method->can('_generate_xs_method');
+
+            my $xs_method = $method->_generate_xs_method
+                or next;
+
+            $self->add_method( $name => $xs_method );
+            push @{ $self->{__immutable}{xs_accessors} ||= [] }, $method;
+        }
+    }
+}
+
+sub _remove_inlined_code {
+    my $self = shift;
+
+    $self->SUPER::_remove_inlined_code(@_);
+
+    _forget_role_set( $self->name );
+
+    # put the perl accessors back in place of the xs ones
+    $self->add_method( $_->name => $_ )
+        for @{ delete $self->{__immutable}{xs_accessors} || [] };
+}
+
 sub _fixup_attributes_after_rebless {
     my $self = shift;
     my ($instance, $rebless_from, %params) = @_;
@@ -933,6 +1016,33 @@ excludes the named role. This tests both the class and its parents.
 This overrides the parent's method in order to allow the parameters to
 be provided as a hash reference.
 
+=item B<< $metaclass->make_immutable(%options) >>
+
+This overrides the parent's method to default C<inline_destructor> to true
+and C<inline_accessors> to false, since Moose always inlines accessors when an
+attribute is created.
+
+It also accepts an C<xs_accessors> option, which defaults to true. When it is
+set, plain readers (no C<lazy> or C<auto_deref>, no method modifiers, and a
+hash-based instance) are replaced by C implementations. So are writers and
+accessors without a C<trigger>, C<coerce> or C<weak_ref>, as long as their
+type constraint, if any, is one of C<Any>, C<Item>, C<Undef>, C<Defined>,
+C<Bool>, C<Value>, C<Ref>, C<Str>, C<Num>, C<Int>, C<CodeRef>, C<ArrayRef>,
+C<HashRef> or C<Object>, or C<Maybe> of one of those. Delegations (from
+C<handles>) through a plain reader are replaced as well, by C versions which
+read the slot themselves, and so are the C<count>, C<get>, C<elements>,
+C<is_empty>, C<exists>, C<keys> and C<length> methods of native traits, along
+with C<inc>, C<dec> and C<toggle> when the attribute has no trigger or
+coercion and its type constraint is the trait's root type. The original perl
+accessors and delegations are put back by C<make_mutable>.
+
+Similarly, the C<xs_constructor> option (also true by default) makes the
+inlined constructor a C function which initializes attributes from a table
+describing them, instead of from generated perl code. Attributes with
+features it doesn't handle, such as coercions, initializers or custom type
+constraints, are still initialized by generated perl code, as is any
+attribute whose value fails its type constraint, so errors are unchanged.
+
 =item B<< $metaclass->constructor_class($class_name) >>
 
 =item B<< $metaclass->destructor_class($class_name) >>
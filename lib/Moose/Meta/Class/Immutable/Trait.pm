@@ -33,11 +33,9 @@ sub does_role {
     (defined $role)
         || throw_exception( RoleNameRequired => class_name => $self->name );
 
-    $self->{__immutable}{does_role} ||= { map { $_->name => 1 } $self->calculate_all_roles_with_inheritance };
-
     my $name = blessed $role ? $role->name : $role;
 
-    return $self->{__immutable}{does_role}{$name};
+    return $self->_role_set->{$name};
 }
 
 1;
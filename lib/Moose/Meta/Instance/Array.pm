@@ -0,0 +1,54 @@
+package Moose::Meta::Instance::Array;
+our $VERSION = '2.4001';
+
+use strict;
+use warnings;
+
+use Class::MOP::MiniTrait;
+
+use parent 'Class::MOP::Instance::Array', 'Moose::Meta::Instance';
+
+Class::MOP::MiniTrait::apply(__PACKAGE__, 'Moose::Meta::Object::Trait');
+
+1;
+
+# ABSTRACT: The Moose Instance metaclass for objects stored in arrays
+
+__END__
+
+=pod
+
+=head1 SYNOPSIS
+
+    package Point;
+
+    use metaclass 'Moose::Meta::Class' => (
+        instance_metaclass => 'Moose::Meta::Instance::Array',
+    );
+    use Moose;
+
+    has x => ( is => 'ro', isa => 'Int' );
+    has y => ( is => 'ro', isa => 'Int' );
+
+    __PACKAGE__->meta->make_immutable;
+
+=head1 DESCRIPTION
+
+This instance metaclass stores Moose objects as blessed array references,
+with each attribute at a fixed index, rather than as hash references. See
+L<Class::MOP::Instance::Array> for the details of the layout and its
+restrictions.
+
+Subclasses of a class using this metaclass use it too, as Moose upgrades
+their instance metaclass to keep it compatible with their parent's.
+
+=head1 INHERITANCE
+
+C<Moose::Meta::Instance::Array> is a subclass of
+L<Class::MOP::Instance::Array> and L<Moose::Meta::Instance>.
+
+=head1 BUGS
+
+See L<Moose/BUGS> for details on reporting bugs.
+
+=cut
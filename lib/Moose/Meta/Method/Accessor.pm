@@ -4,6 +4,7 @@ our $VERSION = '2.4001';
 use strict;
 use warnings;
 
+use Scalar::Util 'weaken';
 use Try::Tiny;
 
 use parent 'Moose::Meta::Method',
@@ -81,6 +82,104 @@ sub _generate_clearer_method {
                                   : $self->SUPER::_generate_clearer_method(@_);
 }
 
+# Returns a copy of this accessor whose body is implemented in C, or nothing
+# if this accessor does anything beyond what the C version knows how to do.
+sub _generate_xs_method {
+    my $self = shift;
+
+    return unless $self->_instance_is_inlinable;
+
+    my $type = $self->accessor_type;
+    my $slot = ( $self->associated_attribute->slots )[0];
+
+    my $body;
+    if ( $type eq 'reader' ) {
+        $body = _new_xs_reader( $slot, $self->body )
+            if $self->_can_generate_xs_reader;
+    }
+    elsif ( $type eq 'writer' ) {
+        $body = _new_xs_writer( $slot, $self->body, $self->_xs_type_name )
+            if $self->_can_generate_xs_writer;
+    }
+    elsif ( $type eq 'accessor' ) {
+        $body = _new_xs_accessor( $slot, $self->body, $self->_xs_type_name )
+            if $self->_can_generate_xs_reader && $self->_can_generate_xs_writer;
+    }
+
+    return unless $body;
+
+    my $xs = $self->clone( body => $body );
+    weaken( $xs->{attribute} );
+
+    return $xs;
+}
+
+my %inline_generator_for = (
+    reader   => '_generate_reader_method_inline',
+    writer   => '_generate_writer_method_inline',
+    accessor => '_generate_accessor_method_inline',
+);
+
+sub _can_generate_xs_reader {
+    my $self = shift;
+
+    return 0 if $self->associated_attribute->is_lazy;
+
+    return $self->_reads_slot_directly;
+}
+
+# Whether calling this accessor as a reader returns the value of the slot
+# whenever the slot exists, as the stock inlined reader does.
+sub _reads_slot_directly {
+    my $self = shift;
+    my $attr = $self->associated_attribute;
+
+    return 0 unless $self->_instance_is_inlinable;
+    return 0 if $attr->should_auto_deref;
+
+    # any extension which changes how the reader is generated needs the
+    # perl version
+    return 0 unless Moose::Util::_is_unmodified(
+        $self, 'Class::MOP::Method::Accessor',
+        $inline_generator_for{ $self->accessor_type },
+    );
+    return 0 unless Moose::Util::_is_unmodified(
+        $attr, 'Moose::Meta::Attribute',
+        qw( _inline_get_value _inline_check_lazy _inline_return_auto_deref ),
+    );
+    return 0 unless Moose::Util::_is_unmodified(
+        $attr, 'Class::MOP::Attribute',
+        qw( _inline_instance_get slots ),
+    );
+
+    return Moose::Util::_is_unmodified(
+        $attr->associated_class->get_meta_instance, 'Class::MOP::Instance',
+        qw( inline_get_slot_value inline_slot_access ),
+    );
+}
+
+sub _can_generate_xs_writer {
+    my $self = shift;
+    my $attr = $self->associated_attribute;
+
+    return 0 if $attr->has_trigger;
+
+    return 0 unless Moose::Util::_is_unmodified(
+        $self, 'Class::MOP::Method::Accessor',
+        $inline_generator_for{ $self->accessor_type },
+    );
+    return 0 unless Moose::Util::_is_unmodified(
+        $attr, 'Moose::Meta::Attribute',
+        qw( _inline_get_old_value_for_trigger _inline_trigger ),
+    );
+
+    return $attr->_can_xs_set_value;
+}
+
+sub _xs_type_name {
+    shift->associated_attribute->_xs_type_name(@_);
+}
+
 sub _writer_value_needs_copy {
     shift->associated_attribute->_writer_value_needs_copy(@_);
 }
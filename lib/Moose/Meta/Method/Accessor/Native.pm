@@ -5,7 +5,7 @@ use strict;
 use warnings;
 
 use Carp qw( confess );
-use Scalar::Util qw( blessed );
+use Scalar::Util qw( blessed weaken );
 
 use Moose::Role;
 
@@ -146,6 +146,54 @@ override _eval_environment => sub {
     return $env;
 };
 
+# Returns a copy of this method whose body is implemented in C, for the
+# operations xs/Native.xs knows about, or nothing.
+sub _generate_xs_method {
+    my $self = shift;
+    my $attr = $self->associated_attribute;
+
+    return unless $self->_slot_access_can_be_inlined;
+    return unless $attr->can('_native_type');
+    return if $self->can('_xs_writer_can_skip_checks')
+        && !$self->_xs_writer_can_skip_checks;
+
+    my $op   = $attr->_native_type . '::' . $self->delegate_to_method;
+    my $role = 'Moose::Meta::Method::Accessor::Native::' . $op;
+
+    # the C version does what the stock role for the operation does
+    return unless Moose::Util::_is_unmodified(
+        $self, $role,
+        grep { $role->can($_) } qw(
+            _return_value _potential_value _inline_check_arguments
+            _minimum_arguments _maximum_arguments
+        ),
+    );
+    return unless Moose::Util::_is_unmodified(
+        $attr, 'Moose::Meta::Attribute',
+        qw( _inline_check_lazy _inline_get_value _inline_instance_set ),
+    );
+    return unless Moose::Util::_is_unmodified(
+        $attr, 'Class::MOP::Attribute',
+        qw( _inline_instance_get _inline_instance_set slots ),
+    );
+    return unless Moose::Util::_is_unmodified(
+        $attr->associated_class->get_meta_instance, 'Class::MOP::Instance',
+        qw( inline_get_slot_value inline_set_slot_value inline_slot_access ),
+    );
+
+    my $body = _new_xs_native_method(
+        $op,
+        ( $attr->slots )[0],
+        $self->curried_arguments,
+        $self->body,
+    ) or return;
+
+    my $xs = $self->clone( body => $body );
+    weaken( $xs->{attribute} );
+
+    return $xs;
+}
+
 sub _slot_access_can_be_inlined {
     my $self = shift;
 
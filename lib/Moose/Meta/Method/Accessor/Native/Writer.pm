@@ -63,6 +63,19 @@ sub _inline_writer_core {
     return @code;
 }
 
+# The C versions of writers only ever store values of the attribute's root
+# type, so they don't check the type constraint
+sub _xs_writer_can_skip_checks {
+    my $self = shift;
+    my $attr = $self->associated_attribute;
+
+    return 0 if $attr->has_trigger;
+    return 0 if $attr->should_coerce && $attr->type_constraint->has_coercion;
+
+    return !$attr->has_type_constraint
+        || $self->_is_root_type( $attr->type_constraint );
+}
+
 sub _inline_process_arguments { return }
 
 sub _inline_check_arguments { return }
@@ -51,7 +51,176 @@ sub new {
 
 sub _initialize_body {
     my $self = shift;
+
     $self->{'body'} = $self->_generate_constructor_method_inline;
+
+    return unless $self->options->{xs_constructor};
+
+    my $subs = $self->_compile_xs_constructor_subs
+        or return;
+
+    $self->_after_compile( sub {
+        my $body = $self->{'body'};
+        my $xs   = $self->_generate_xs_constructor( $body, $subs->() )
+            or return;
+        $self->_replace_body( $body, $xs );
+    } );
+}
+
+# Compiles the subs the C constructor calls for whatever it doesn't handle
+# itself (calls for subclasses, custom BUILDARGS, unusual attributes, type
+# errors), from the same code as the perl constructor, so the two behave
+# identically. Returns a sub which returns them.
+sub _compile_xs_constructor_subs {
+    my $self = shift;
+
+    return unless $self->_can_generate_xs_constructor;
+
+    my $meta  = $self->associated_metaclass;
+    my @attrs = sort { $a->name cmp $b->name } $meta->get_all_attributes;
+
+    my @initializers
+        = map { [ $meta->_inline_slot_initializer( $attrs[$_], $_ ) ] }
+        0 .. $#attrs;
+
+    return $self->_compile_code( [
+        'sub {',
+            '[',
+                'sub {',
+                    'my $class = shift;',
+                    $meta->_inline_params( '$params', '$class' ),
+                    '$params;',
+                '},',
+                'sub {',
+                    'my ($class, $params) = @_;',
+                    $meta->_inline_generate_instance( '$instance', '$class' ),
+                    $meta->_inline_slot_initializers,
+                    $meta->_inline_extra_init,
+                    'return $instance;',
+                '},',
+                ( map {
+                    @{$_}
+                        ? ( 'sub {',
+                                'my ($instance, $params) = @_;',
+                                @{$_},
+                            '},' )
+                        : 'undef,'
+                } @initializers ),
+            ']',
+        '}',
+    ] );
+}
+
+# Returns a C constructor which initializes attributes from a table built
+# here, rather than from generated code.
+sub _generate_xs_constructor {
+    my $self = shift;
+    my ( $fallback, $subs ) = @_;
+
+    my $meta  = $self->associated_metaclass;
+    my @attrs = sort { $a->name cmp $b->name } $meta->get_all_attributes;
+
+    my ( $buildargs_sub, $body, @initializer_subs ) = @{$subs};
+
+    my $slots_in_c = Moose::Util::_is_unmodified(
+        $meta, 'Moose::Meta::Class',
+        qw(
+            _inline_slot_initializer _inline_check_required_attr
+            _inline_init_attr_from_constructor _inline_init_attr_from_default
+            _inline_default_value
+            ),
+    );
+
+    my $buildargs = $meta->find_method_by_name('BUILDARGS');
+
+    my @attr_specs;
+    for my $i ( 0 .. $#attrs ) {
+        my $attr = $attrs[$i];
+
+        my %spec = (
+            slot        => ( $attr->slots )[0],
+            init_arg    => $attr->init_arg,
+            initializer => $initializer_subs[$i],
+        );
+
+        $spec{trigger} = $attr->trigger
+            if $attr->can('has_trigger') && $attr->has_trigger;
+
+        if (   $slots_in_c
+            && $attr->isa('Moose::Meta::Attribute')
+            && !$attr->has_initializer
+            && $attr->_can_xs_set_value ) {
+
+            $spec{in_c} = 1;
+            $spec{type} = $attr->_xs_type_name;
+            $spec{required}
+                = defined $attr->init_arg
+                && $attr->is_required
+                && !$attr->has_default
+                && !$attr->has_builder;
+
+            if ( $attr->is_lazy ) {
+                # initialized on first access instead
+            }
+            elsif ( $attr->has_default ) {
+                $spec{default_kind}
+                    = $attr->is_default_a_coderef ? 'code' : 'value';
+                $spec{default} = $attr->default;
+            }
+            elsif ( $attr->has_builder ) {
+                $spec{default_kind} = 'builder';
+                $spec{default}      = $attr->builder;
+            }
+        }
+
+        push @attr_specs, \%spec;
+    }
+
+    return _new_xs_constructor( {
+        class_name => $meta->name,
+        fallback   => $fallback,
+        buildargs  => $buildargs_sub,
+        buildargs_in_c =>
+            ( !$buildargs || $buildargs->body == \&Moose::Object::BUILDARGS ),
+        body       => $body,
+        attributes => \@attr_specs,
+        builds     => [
+            map { $_->{class} . '::BUILD' }
+                reverse $meta->find_all_methods_by_name('BUILD')
+        ],
+    } );
+}
+
+sub _can_generate_xs_constructor {
+    my $self = shift;
+    my $meta = $self->associated_metaclass;
+
+    # the perl constructor stores the metaclass in each instance here
+    return 0 if Class::MOP::metaclass_is_weak( $meta->name );
+
+    return 0 unless Moose::Util::_is_unmodified(
+        $self, 'Class::MOP::Method::Constructor',
+        qw( _generate_constructor_method_inline ),
+    );
+    return 0 unless Moose::Util::_is_unmodified(
+        $meta, 'Moose::Meta::Class',
+        qw(
+            _inline_new_object _inline_fallback_constructor
+            _generate_fallback_constructor _inline_params _inline_BUILDARGS
+            _inline_generate_instance _inline_create_instance
+            _inline_slot_initializers _inline_preserve_weak_metaclasses
+            _inline_extra_init _inline_triggers _inline_BUILDALL
+            ),
+    );
+
+    my $mi = $meta->get_meta_instance;
+    return $mi->is_inlinable && Moose::Util::_is_unmodified(
+        $mi, 'Class::MOP::Instance',
+        qw(
+            create_instance inline_create_instance inline_slot_access
+            inline_get_slot_value inline_set_slot_value
+            ),
+    );
 }
 
 1;
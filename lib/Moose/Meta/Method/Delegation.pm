@@ -51,7 +51,7 @@ sub new {
 
     weaken( $self->{'attribute'} );
 
-    $self->_initialize_body;
+    $self->_initialize_body_lazily;
 
     return $self;
 }
@@ -160,6 +160,45 @@ EOF
     };
 }
 
+# Returns a copy of this delegation whose body is implemented in C, or nothing
+# if the attribute isn't read by a plain reader. The C version reads the slot
+# itself rather than calling the reader, and calls the delegated method with
+# the caller's arguments in place.
+sub _generate_xs_method {
+    my $self = shift;
+    my $attr = $self->associated_attribute;
+
+    return if ref $self->delegate_to_method;
+    return unless $attr->has_read_method;
+
+    return unless Moose::Util::_is_unmodified(
+        $self, 'Moose::Meta::Method::Delegation',
+        qw( _initialize_body _generate_inline_method ),
+    );
+
+    my $class  = $attr->associated_class;
+    my $reader = $class->_get_maybe_raw_method( $attr->get_read_method );
+    return unless blessed $reader
+        && $reader->isa('Moose::Meta::Method::Accessor')
+        && $reader->associated_attribute == $attr
+        && $reader->accessor_type =~ /^(?:reader|accessor)$/
+        && $reader->_reads_slot_directly;
+
+    my $xs = $self->clone(
+        body => _new_xs_delegation(
+            $class->name,
+            ( $attr->slots )[0],
+            $attr->get_read_method,
+            $self->delegate_to_method,
+            $self->curried_arguments,
+            $self->body,
+        ),
+    );
+    weaken( $xs->{attribute} );
+
+    return $xs;
+}
+
 sub _eval_environment {
     my $self = shift;
 
@@ -116,18 +116,34 @@ sub _generate_DEMOLISHALL {
     my @methods = $self->associated_metaclass->find_all_methods_by_name('DEMOLISH');
     return unless @methods;
 
+    # the same as Moose::Object::DESTROY
     return (
         'local $?;',
-        'my $igd = Devel::GlobalDestruction::in_global_destruction;',
-        'Try::Tiny::try {',
-            (map { $inv . '->' . $_->{class} . '::DEMOLISH($igd);' } @methods),
+        'my $igd = ' . $self->_inline_in_global_destruction . ';',
+        'my $prev_error = $@;',
+        'my ($failed, $error);',
+        '{',
+            'local $@;',
+            '$failed = !eval {',
+                '$@ = $prev_error;',
+                (map { $inv . '->' . $_->{class} . '::DEMOLISH($igd);' } @methods),
+                '1;',
+            '};',
+            '$error = $@;',
         '}',
-        'Try::Tiny::catch {',
-            'die $_;',
-        '};',
+        'die $error if $failed;',
     );
 }
 
+sub _inline_in_global_destruction {
+    my $self = shift;
+
+    # this is all Devel::GlobalDestruction does on perls which have it
+    return "$]" >= 5.014
+        ? q{${^GLOBAL_PHASE} eq 'DESTRUCT'}
+        : 'Devel::GlobalDestruction::in_global_destruction';
+}
+
 
 1;
 
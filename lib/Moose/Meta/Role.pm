@@ -407,6 +407,7 @@ sub add_role {
                           );
     push @{$self->get_roles} => $role;
     $self->reset_package_cache_flag;
+    Moose::Meta::Class::_role_sets_changed();
 }
 
 sub calculate_all_roles {
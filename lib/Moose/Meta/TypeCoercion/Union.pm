@@ -25,7 +25,7 @@ sub compile_type_coercion {
             my $value = shift;
 
             foreach my $type ( grep { $_->has_coercion }
-                @{ $type_constraint->type_constraints } ) {
+                $type_constraint->_ordered_type_constraints ) {
                 my $temp = $type->coerce($value);
                 return $temp if $type_constraint->check($temp);
             }
@@ -69,7 +69,8 @@ union type coercion.
 =head2 $coercion->coerce($value)
 
 This method will coerce by trying the coercions for each type in the
-union.
+union. For adaptive unions, they are tried in the order the union
+currently checks its members, rather than the order they were given in.
 
 =head1 BUGS
 
@@ -205,6 +205,12 @@ sub inline_environment {
     return $self->_inline_environment;
 }
 
+# Types which replace the values stored in attributes by shared copies (see
+# the intern option of Moose::Meta::TypeConstraint::Enum) override these.
+sub _interner { return }
+
+sub _inline_intern_value { return }
+
 sub assert_valid {
     my ( $self, $value ) = @_;
 
@@ -320,7 +326,7 @@ sub _compile_subtype {
         # general case, check all the constraints, from the first parent to ourselves
         my @checks = @parents;
         push @checks, $check if $check != $null_constraint;
-        return set_subname(
+        my $compiled = set_subname(
             $self->name => sub {
                 my (@args) = @_;
                 local $_ = $args[0];
@@ -330,7 +336,79 @@ sub _compile_subtype {
                 return 1;
             }
         );
+
+        return $compiled if $ENV{MOOSE_NO_XS_TYPE_CHECKS};
+
+        # the same checks, run by the C code in xs/TypeConstraint.xs
+        return set_subname(
+            $self->name => _new_xs_check( $self->_check_program($check), $compiled )
+        );
+    }
+}
+
+# Lowers the checks done by the closure above into ops for the C code, in
+# the same order. Each op comes with the perl code doing the same check,
+# which the C code calls for values it can't decide on its own. Builtin and
+# class types end the program, as their ops check what their parents do too.
+sub _check_program {
+    my ( $self, $check ) = @_;
+
+    my @ops;
+    for ( my $type = $self; $type; $type = $type->parent ) {
+        if ( $type->_is_builtin ) {
+            unshift @ops,
+                [ builtin => $type->_compiled_type_constraint, $type->name ];
+            last;
+        }
+
+        if ( $type->isa('Moose::Meta::TypeConstraint::Class')
+            && Moose::Util::_is_unmodified(
+                $type, 'Moose::Meta::TypeConstraint::Class',
+                qw( constraint _inline_check _actually_compile_type_constraint )
+            )
+            ) {
+            unshift @ops, [ isa => $type->_compiled_type_constraint ];
+            last;
+        }
+
+        my $constraint = $type == $self ? $check : $type->constraint;
+        next if $constraint == $null_constraint;
+
+        unshift @ops, $type->_check_program_op($constraint);
+    }
+
+    return \@ops;
+}
+
+sub _check_program_op {
+    my ( $self, $constraint ) = @_;
+
+    if ( $self->isa('Moose::Meta::TypeConstraint::Enum')
+        && Moose::Util::_is_unmodified(
+            $self, 'Moose::Meta::TypeConstraint::Enum', 'constraint'
+        )
+        ) {
+        return [ enum => $constraint, $self->_compiled_type_constraint ];
+    }
+
+    if ( $self->isa('Moose::Meta::TypeConstraint::Parameterized')
+        && $self->parent->_is_builtin ) {
+        my %opname_for = (
+            ArrayRef => 'all_array',
+            HashRef  => 'all_hash',
+            Maybe    => 'maybe',
+        );
+
+        my $opname = $opname_for{ $self->parent->name };
+        return [
+            $opname => $constraint,
+            $self->type_parameter->_compiled_type_constraint
+            ]
+            if $opname
+            && $self->type_parameter->_has_compiled_type_constraint;
     }
+
+    return [ perl => $constraint ];
 }
 
 sub _compile_type {
@@ -349,6 +427,43 @@ sub _compile_type {
 
 ## other utils ...
 
+# Whether this is one of the types defined in
+# Moose::Util::TypeConstraints::Builtins, rather than something which merely
+# shares a name with one of them.
+sub _is_builtin {
+    my $self = shift;
+
+    my $registered
+        = Moose::Util::TypeConstraints::find_type_constraint( $self->name );
+
+    return $registered
+        && refaddr($registered) == refaddr($self)
+        && ( $self->_package_defined_in || '' ) eq
+        'Moose::Util::TypeConstraints::Builtins';
+}
+
+# The name under which the C code in mop.c knows this type, if it is one of
+# the builtin types it can check, or Maybe of one.
+sub _xs_type_name {
+    my $self = shift;
+
+    my $name;
+    if ( $self->isa('Moose::Meta::TypeConstraint::Parameterized') ) {
+        my $maybe = Moose::Util::TypeConstraints::find_type_constraint('Maybe');
+        return undef
+            unless refaddr( $self->parent ) == refaddr($maybe)
+            && $self->type_parameter->_is_builtin;
+
+        $name = 'Maybe[' . $self->type_parameter->name . ']';
+    }
+    else {
+        return undef unless $self->_is_builtin;
+        $name = $self->name;
+    }
+
+    return _xs_knows_type($name) ? $name : undef;
+}
+
 sub _collect_all_parents {
     my $self = shift;
     my @parents;
@@ -529,6 +644,14 @@ Returns true if this type constraint can be inlined. A type constraint which
 subtypes an inlinable constraint and does not add an additional constraint
 "inherits" its parent type's inlining.
 
+Type constraints which cannot be inlined but have a parent are checked by C
+code which runs the checks of the type and all its parents in turn, calling
+back into Perl only for the constraints it has no C equivalent for (the
+builtin types, class types, enums, and C<ArrayRef>, C<HashRef> or C<Maybe> of
+other types are all checked in C). Setting the C<MOOSE_NO_XS_TYPE_CHECKS>
+environment variable disables this, so that every constraint is checked by
+calling its Perl code.
+
 =head2 $constraint->create_child_type(%options)
 
 This returns a new type constraint of the same class using the
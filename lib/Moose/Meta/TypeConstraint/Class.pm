@@ -42,6 +42,24 @@ sub new {
     return $self;
 }
 
+# The compiled check is C code which caches its answer for each class of
+# object it sees (see xs/TypeConstraint.xs), falling back to perl for
+# classes with their own isa method. The inlined check stays plain perl, as
+# other types' inlined checks embed it without our inline environment.
+sub _actually_compile_type_constraint {
+    my $self = shift;
+
+    return $self->SUPER::_actually_compile_type_constraint(@_)
+        unless $self->inlined == $inliner;
+
+    my $class_name = $self->class;
+
+    return _new_xs_check(
+        $class_name,
+        sub { Scalar::Util::blessed( $_[0] ) && $_[0]->isa($class_name) },
+    );
+}
+
 sub parents {
     my $self = shift;
     return (
@@ -17,6 +17,16 @@ __PACKAGE__->meta->add_attribute('values' => (
     Class::MOP::_definition_context(),
 ));
 
+__PACKAGE__->meta->add_attribute('intern' => (
+    reader => 'intern',
+    Class::MOP::_definition_context(),
+));
+
+__PACKAGE__->meta->add_attribute('_interner' => (
+    accessor => '_interner',
+    Class::MOP::_definition_context(),
+));
+
 __PACKAGE__->meta->add_attribute('_inline_var_name' => (
     accessor => '_inline_var_name',
     Class::MOP::_definition_context(),
@@ -72,6 +82,12 @@ sub new {
     $self->compile_type_constraint()
         unless $self->_has_compiled_type_constraint;
 
+    if ( $self->intern ) {
+        my $interner = _new_xs_interner( $self->_compiled_type_constraint );
+        $self->_interner($interner);
+        $self->inline_environment->{ '$' . $var_name . '_intern' } = \$interner;
+    }
+
     $self->message( sub {
         my $value = shift;
         sprintf(
@@ -84,6 +100,26 @@ sub new {
     return $self;
 }
 
+sub _inline_intern_value {
+    my $self = shift;
+    my $val  = shift;
+
+    return unless $self->intern;
+
+    return $val . ' = $' . $self->_inline_var_name . '_intern->(' . $val . ');';
+}
+
+# The inlined check, done by C code which looks the value up in a perfect
+# hash of the values (see xs/TypeConstraint.xs).
+sub _actually_compile_type_constraint {
+    my $self = shift;
+
+    return $self->SUPER::_actually_compile_type_constraint(@_)
+        unless $self->inlined == $inliner;
+
+    return _new_xs_check( $self->values );
+}
+
 sub equals {
     my ( $self, $type_or_name ) = @_;
 
@@ -152,11 +188,20 @@ values. Second, it automatically sets the parent to the C<Str> type.
 Finally, it ignores any provided C<constraint> option. The constraint
 is generated automatically based on the provided C<values>.
 
+It also accepts an C<intern> option. If this is true, attributes of this
+type store a shared copy of each value instead of the value itself, so
+that objects holding the same value don't each store their own copy of
+its string.
+
 =head2 $constraint->values
 
 Returns the array reference of acceptable values provided to the
 constructor.
 
+=head2 $constraint->intern
+
+Returns true if the type was created with the C<intern> option.
+
 =head2 $constraint->create_child_type
 
 This returns a new L<Moose::Meta::TypeConstraint> object with the type
@@ -7,6 +7,7 @@ use metaclass;
 
 use Moose::Meta::TypeCoercion::Union;
 
+use Eval::Closure;
 use List::Util 1.33 qw(first all);
 
 use parent 'Moose::Meta::TypeConstraint';
@@ -17,12 +18,49 @@ __PACKAGE__->meta->add_attribute('type_constraints' => (
     Class::MOP::_definition_context(),
 ));
 
+__PACKAGE__->meta->add_attribute('adaptive' => (
+    reader => 'adaptive',
+    Class::MOP::_definition_context(),
+));
+
+# For adaptive unions, an array ref shared by all the code checking the
+# union. It holds the current check, the indexes of the members in the order
+# it tries them, how often each member matched, the number of checks left
+# until the order is looked at again, the members, and the previous check.
+__PACKAGE__->meta->add_attribute('_adaptive_state' => (
+    accessor => '_adaptive_state',
+    Class::MOP::_definition_context(),
+));
+
+__PACKAGE__->meta->add_attribute('_adaptive_index' => (
+    accessor => '_adaptive_index',
+    Class::MOP::_definition_context(),
+));
+
+my $adapt_interval = 1000;
+
+# the states of all adaptive unions, so that their inlined checks can reach
+# them by a fully qualified name. Code inlining the check of a type doesn't
+# always carry its inline environment, for instance when a subtype's
+# inline_as embeds its parent's check.
+our @_adaptive_states;
+
 sub new {
     my ($class, %options) = @_;
 
     my $name = join '|' => sort { $a cmp $b }
         map { $_->name } @{ $options{type_constraints} };
 
+    if ( $options{adaptive} ) {
+        my @members = @{ $options{type_constraints} };
+        $options{_adaptive_state} = [
+            undef, [ 0 .. $#members ], [ (0) x @members ], $adapt_interval,
+            \@members, undef,
+        ];
+        push @_adaptive_states, $options{_adaptive_state};
+        $options{_adaptive_index} = $#_adaptive_states;
+    }
+
     my $self = $class->SUPER::new(
         name => $name,
         %options,
@@ -60,6 +98,11 @@ sub has_coercion {
 sub _actually_compile_type_constraint {
     my $self = shift;
 
+    if ( my $state = $self->_adaptive_state ) {
+        $state->[0] ||= _compile_ordered_check($state);
+        return sub { $state->[0]->(@_) };
+    }
+
     my @constraints = @{ $self->type_constraints };
 
     return sub {
@@ -71,9 +114,97 @@ sub _actually_compile_type_constraint {
     };
 }
 
+# The check of an adaptive union, trying the members in the current order
+# and counting which one matched.
+sub _compile_ordered_check {
+    my $state = shift;
+    my ( $order, $hits, $members ) = @{$state}[ 1, 2, 4 ];
+
+    my %env;
+    my @checks;
+    my @source = (
+        'Scalar::Util::weaken($state);',
+        'sub {',
+            'Moose::Meta::TypeConstraint::Union::_adapt($state)',
+                'unless --$state->[3];',
+    );
+    for my $i ( @{$order} ) {
+        my $member = $members->[$i];
+        my $check;
+        if ( $member->can_be_inlined ) {
+            $check = $member->_inline_check('$_[0]');
+            %env = ( %env, %{ $member->inline_environment } );
+        }
+        else {
+            $check = '$member_checks[' . $i . ']->($_[0])';
+            $checks[$i] = $member->_compiled_type_constraint;
+        }
+        push @source,
+            'if (' . $check . ') {',
+                '$hits->[' . $i . ']++;',
+                'return 1;',
+            '}';
+    }
+    push @source, (
+            'return undef;',
+        '}',
+    );
+
+    return eval_closure(
+        source      => \@source,
+        environment => {
+            %env,
+            '$state'         => \$state,
+            '$hits'          => \$hits,
+            '@member_checks' => \@checks,
+        },
+    );
+}
+
+# Puts the members which matched most often first, recompiling the check if
+# that changes their order. The hit counts are halved so that the order can
+# follow changes in the values being checked.
+sub _adapt {
+    my $state = shift;
+    my ( $order, $hits ) = @{$state}[ 1, 2 ];
+
+    $state->[3] = $adapt_interval;
+
+    my %position;
+    @position{ @{$order} } = 0 .. $#{$order};
+    my @new_order = sort {
+        $hits->[$b] <=> $hits->[$a] || $position{$a} <=> $position{$b}
+    } @{$order};
+
+    $_ >>= 1 for @{$hits};
+
+    return if join( ',', @new_order ) eq join( ',', @{$order} );
+
+    $state->[1] = \@new_order;
+
+    # the old check may be the one calling us, so keep it alive for a while
+    $state->[5] = $state->[0];
+    $state->[0] = _compile_ordered_check($state);
+
+    return;
+}
+
+# The members, in the order adaptive unions currently try them.
+sub _ordered_type_constraints {
+    my $self = shift;
+
+    my $state = $self->_adaptive_state
+        or return @{ $self->type_constraints };
+
+    return @{ $state->[4] }[ @{ $state->[1] } ];
+}
+
 sub can_be_inlined {
     my $self = shift;
 
+    # adaptive unions inline a call to their current check
+    return 1 if $self->adaptive;
+
     # This was originally done with all() from List::MoreUtils, but that
     # caused some sort of bizarro parsing failure under 5.10.
     for my $tc ( @{ $self->type_constraints } ) {
@@ -87,6 +218,11 @@ sub _inline_check {
     my $self = shift;
     my $val  = shift;
 
+    if ( $self->adaptive ) {
+        return '$' . __PACKAGE__ . '::_adaptive_states['
+            . $self->_adaptive_index . '][0]->(' . $val . ')';
+    }
+
     return '('
                . (
                   join ' || ', map { '(' . $_->_inline_check($val) . ')' }
@@ -98,6 +234,8 @@ sub _inline_check {
 sub inline_environment {
     my $self = shift;
 
+    return {} if $self->adaptive;
+
     return { map { %{ $_->inline_environment } }
             @{ $self->type_constraints } };
 }
@@ -224,6 +362,13 @@ containing the L<Moose::Meta::TypeConstraint> objects that are the
 members of the union type. The C<name> option defaults to the names
 all of these member types sorted and then joined by a pipe (|).
 
+It also accepts an C<adaptive> option. An adaptive union counts which of
+its members values match, and every thousand checks it recompiles its check
+so that the members matching most often are tried first. Since a
+L<Moose::Meta::TypeCoercion::Union> tries the coercions of the members in
+the same order, this should only be used for unions whose members don't
+have coercions which apply to the same values.
+
 The constructor sets the implementation of the constraint so that is
 simply calls C<check> on the newly created object.
 
@@ -235,6 +380,10 @@ attribute is a L<Moose::Meta::TypeCoercion::Union> object.
 This returns the array reference of C<type_constraints> provided to
 the constructor.
 
+=head2 $constraint->adaptive
+
+Returns true if the union was created with the C<adaptive> option.
+
 =head2 $constraint->parent
 
 This returns the nearest common ancestor of all the components of the union.
@@ -259,7 +408,8 @@ unions have the same member types.
 
 This returns the first member type constraint for which C<check($value)> is
 true, allowing you to determine which of the Union's member type constraints
-a given value matches.
+a given value matches. The members are always tried in the order they were
+given, even for adaptive unions.
 
 =head2 $constraint->is_a_type_of($type_name_or_object)
 
@@ -8,7 +8,6 @@ use Carp ();
 use Devel::GlobalDestruction ();
 use MRO::Compat ();
 use Scalar::Util ();
-use Try::Tiny ();
 
 use Moose::Util ();
 
@@ -24,24 +23,7 @@ sub new {
     return Class::MOP::Class->initialize($real_class)->new_object($params);
 }
 
-sub BUILDARGS {
-    my $class = shift;
-    if ( scalar @_ == 1 ) {
-        unless ( defined $_[0] && ref $_[0] eq 'HASH' ) {
-            Moose::Util::throw_exception( "SingleParamsToNewMustBeHashRef" );
-        }
-        return { %{ $_[0] } };
-    }
-    elsif ( @_ % 2 ) {
-        Carp::carp(
-            "The new() method for $class expects a hash reference or a key/value list."
-                . " You passed an odd number of arguments" );
-        return { @_, undef };
-    }
-    else {
-        return { @_ };
-    }
-}
+# BUILDARGS is implemented in XS (xs/Object.xs)
 
 sub BUILDALL {
     # NOTE: we ask Perl if we even
@@ -92,30 +74,40 @@ sub DESTROY {
     # < doy> if the destructor is being called because an exception is thrown, then $@ will be set
     # < doy> but if DEMOLISH does an eval which succeeds, that will clear $@
     # < doy> which is broken
-    # < doy> try::tiny implicitly localizes $@ in the try block, which fixes that
-    Try::Tiny::try {
-        $self->DEMOLISHALL(Devel::GlobalDestruction::in_global_destruction);
+    # so DEMOLISHALL runs in an eval with $@ localized (and set back to the
+    # error being thrown, if any), the way try::tiny would run it, but
+    # without the closures
+    my $prev_error = $@;
+    my ( $failed, $error );
+    {
+        local $@;
+        $failed = !eval {
+            $@ = $prev_error;
+            $self->DEMOLISHALL(Devel::GlobalDestruction::in_global_destruction);
+            1;
+        };
+        $error = $@;
     }
-    Try::Tiny::catch {
-        die $_;
-    };
+    die $error if $failed;
 
     return;
 }
 
 # support for UNIVERSAL::DOES ...
+# DOES() is implemented in XS, and answers from the same set of roles as
+# does(), calling this for anything which isn't in it
 BEGIN {
     my $does = UNIVERSAL->can("DOES") ? "SUPER::DOES" : "isa";
-    eval 'sub DOES {
+    eval 'sub _DOES {
         my ( $self, $class_or_role_name ) = @_;
         return $self->'.$does.'($class_or_role_name)
             || $self->does($class_or_role_name);
     }';
 }
 
-# new does() methods will be created
-# as appropriate see Moose::Meta::Role
-sub does {
+# does() is implemented in XS, and answers from the set of roles kept for
+# the class by Moose::Meta::Class::_role_set, calling this when there is none
+sub _does {
     my ($self, $role_name) = @_;
     my $class = Scalar::Util::blessed($self) || $self;
     my $meta = Class::MOP::Class->initialize($class);
@@ -351,6 +351,19 @@ sub _load_user_class {
     );
 }
 
+# Whether none of the given methods have been overridden (by a subclass or a
+# role) relative to $class. The C implementations used by immutable classes
+# only stand in for code generated by the stock methods.
+sub _is_unmodified {
+    my ( $object, $class, @methods ) = @_;
+
+    for my $method (@methods) {
+        return 0 unless ( $object->can($method) || 0 ) == $class->can($method);
+    }
+
+    return 1;
+}
+
 # XXX - this should be added to Params::Util
 sub _STRINGLIKE0 ($) {
     return 0 if !defined $_[0];
@@ -81,6 +81,7 @@ sub _create_type_constraint_union {
     my $name;
     $name = shift if @_ > 1;
     my @tcs = @{ shift() };
+    my $extra_options = shift;
 
     my @type_constraint_names;
 
@@ -100,6 +101,7 @@ sub _create_type_constraint_union {
     } @type_constraint_names;
 
     my %options = (
+      ( $extra_options ? %{$extra_options} : () ),
       type_constraints => \@type_constraints
     );
     $options{name} = $name if defined $name;
@@ -430,8 +432,10 @@ sub enum {
         @values    = ($type_name);
         $type_name = undef;
     }
-    if ( @values == 1 && ref $values[0] eq 'ARRAY' ) {
-        @values = @{ $values[0] };
+    my %options;
+    if ( ref $values[0] eq 'ARRAY' ) {
+        ( my $values, %options ) = @values;
+        @values = @{$values};
     }
     else {
         Moose::Deprecated::deprecated(
@@ -445,6 +449,7 @@ sub enum {
         create_enum_type_constraint(
             $type_name,
             \@values,
+            \%options,
         )
     );
 }
@@ -459,26 +464,45 @@ sub union {
     @constraints = @$type_name;
     $type_name   = undef;
   }
-  if ( @constraints == 1 && ref $constraints[0] eq 'ARRAY' ) {
-    @constraints = @{ $constraints[0] };
+  my %options;
+  if ( ref $constraints[0] eq 'ARRAY' ) {
+    ( my $constraints, %options ) = @constraints;
+    @constraints = @{$constraints};
   }
+  _check_type_constraint_options( union => \%options, 'adaptive' );
   if ( defined $type_name ) {
     return register_type_constraint(
-      create_named_type_constraint_union( $type_name, @constraints )
+      _create_type_constraint_union( $type_name, \@constraints, \%options )
     );
   }
   return create_type_constraint_union( @constraints );
 }
 
 sub create_enum_type_constraint {
-    my ( $type_name, $values ) = @_;
+    my ( $type_name, $values, $options ) = @_;
+
+    _check_type_constraint_options( enum => $options, 'intern' );
 
     Moose::Meta::TypeConstraint::Enum->new(
+        ( defined $options ? %{$options} : () ),
         name => $type_name || '__ANON__',
         values => $values,
     );
 }
 
+sub _check_type_constraint_options {
+    my ( $function, $options, @valid ) = @_;
+
+    my %valid = map { $_ => 1 } @valid;
+    my @invalid = sort grep { !$valid{$_} } keys %{ $options || {} };
+
+    throw_exception( InvalidTypeConstraintOptions => function        => $function,
+                                                     invalid_options => \@invalid,
+                                                     valid_options   => \@valid
+                   )
+        if @invalid;
+}
+
 sub create_duck_type_constraint {
     my ( $type_name, $methods ) = @_;
 
@@ -1048,6 +1072,16 @@ See the L</SYNOPSIS> for a simple example.
 B<NOTE:> This is not a true proper enum type, it is simply
 a convenient constraint builder.
 
+=head3 enum ($name, \@values, %options)
+
+The only option is C<intern>, and any other option is an error. When it is
+true, attributes with this type store a shared copy of their value, whose
+string is stored only once however many objects hold it:
+
+  enum 'Status', [qw( new open closed )], intern => 1;
+
+  has status => ( is => 'rw', isa => 'Status' );
+
 =head3 enum (\@values)
 
 If passed an ARRAY reference as the only parameter instead of the
@@ -1064,10 +1098,22 @@ can then be used in an attribute definition like so:
 This will create a basic subtype where any of the provided constraints
 may match in order to satisfy this constraint.
 
+=head3 union ($name, \@constraints, %options)
+
+The only option is C<adaptive>, and any other option is an error. When it is
+true, the union keeps track of which of its constraints values match, and
+reorders its checks every so often so that the constraint matching most often
+is tried first:
+
+  union 'Input', [qw( Str ArrayRef[Str] HashRef )], adaptive => 1;
+
+See L<Moose::Meta::TypeConstraint::Union> for how this affects coercions.
+
 =head3 union (\@constraints)
 
 If passed an ARRAY reference as the only parameter instead of the
 C<$name>, C<\@constraints> pair, this will create an unnamed union.
+An unnamed union can't take any options, so it is never adaptive.
 This can then be used in an attribute definition like so:
 
   has 'items' => (
@@ -1305,11 +1351,14 @@ L<Moose::Meta::TypeConstraint::Role> object for that role name.
 The C<$options> is a hash reference that will be passed to the
 L<Moose::Meta::TypeConstraint::Role> constructor (as a hash).
 
-=head3 create_enum_type_constraint($name, $values)
+=head3 create_enum_type_constraint($name, $values, $options)
 
 Given a enum name this function will create a new
 L<Moose::Meta::TypeConstraint::Enum> object for that enum name.
 
+The C<$options> is an optional hash reference of the options described under
+L</enum ($name, \@values, %options)>. Any other key is an error.
+
 =head3 create_duck_type_constraint($name, $methods)
 
 Given a duck type name this function will create a new
@@ -76,41 +76,18 @@ sub define_builtins {
             . ')'
         };
 
-    my $value_type = Moose::Util::TypeConstraints::find_type_constraint('Value');
     subtype 'Num'
         => as 'Str'
-        => where {
-        my $val = $_;
-        ($val =~ /\A[+-]?[0-9]+\z/) ||
-        ( $val =~ /\A(?:[+-]?)              # matches optional +- in the beginning
-        (?=[0-9]|\.[0-9])                   # matches previous +- only if there is something like 3 or .3
-        [0-9]*                              # matches 0-9 zero or more times
-        (?:\.[0-9]+)?                       # matches optional .89 or nothing
-        (?:[Ee](?:[+-]?[0-9]+))?            # matches E1 or e1 or e-1 or e+1 etc
-        \z/x );
-           }
+        => where( \&_Num )
         => inline_as {
-            # the long Str tests are redundant here
-        #storing $_[1] in a temporary value,
-        #so that $_[1] won't get converted to a string for regex match
-        #see t/attributes/numeric_defaults.t for more details
-        'my $val = '.$_[1].';'.
-        $value_type->_inline_check('$val')
-        .' && ( $val =~ /\A[+-]?[0-9]+\z/ || '
-        . '$val =~ /\A(?:[+-]?)             # matches optional +- in the beginning
-                (?=[0-9]|\.[0-9])           # matches previous +- only if there is something like 3 or .3
-                [0-9]*                      # matches 0-9 zero or more times
-                (?:\.[0-9]+)?               # matches optional .89 or nothing
-                (?:[Ee](?:[+-]?[0-9]+))?    # matches E1 or e1 or e-1 or e+1 etc
-                \z/x ); '
+            'Moose::Util::TypeConstraints::Builtins::_Num(' . $_[1] . ')'
         };
 
     subtype 'Int'
         => as 'Num'
-        => where { (my $val = $_) =~ /\A-?[0-9]+\z/ }
+        => where( \&_Int )
         => inline_as {
-            $value_type->_inline_check($_[1])
-            . ' && (my $val = ' . $_[1] . ') =~ /\A-?[0-9]+\z/'
+            'Moose::Util::TypeConstraints::Builtins::_Int(' . $_[1] . ')'
         };
 
     subtype 'CodeRef'
@@ -220,13 +197,23 @@ sub define_builtins {
                 my $type_parameter = shift;
                 my $val            = shift;
 
+                my $all = '&List::Util::all('
+                    . 'sub { ' . $type_parameter->_inline_check('$_') . ' }, '
+                    . '@{$check}'
+                    . ')';
+
+                # walk the elements in C if it knows the type, leaving
+                # anything it isn't sure about to perl
+                my $xs_type_name = $type_parameter->_xs_type_name;
+                $all = '(Moose::Util::TypeConstraints::Builtins::_xs_all_array('
+                    . "'$xs_type_name', " . '$check'
+                    . ') || ' . $all . ')'
+                    if defined $xs_type_name;
+
                 'do {'
                     . 'my $check = ' . $val . ';'
                     . 'ref($check) eq "ARRAY" '
-                        . '&& &List::Util::all('
-                            . 'sub { ' . $type_parameter->_inline_check('$_') . ' }, '
-                            . '@{$check}'
-                        . ')'
+                        . '&& ' . $all
                 . '}';
             },
         )
@@ -255,13 +242,23 @@ sub define_builtins {
                 my $type_parameter = shift;
                 my $val            = shift;
 
+                my $all = '&List::Util::all('
+                    . 'sub { ' . $type_parameter->_inline_check('$_') . ' }, '
+                    . 'values %{$check}'
+                    . ')';
+
+                # walk the elements in C if it knows the type, leaving
+                # anything it isn't sure about to perl
+                my $xs_type_name = $type_parameter->_xs_type_name;
+                $all = '(Moose::Util::TypeConstraints::Builtins::_xs_all_hash('
+                    . "'$xs_type_name', " . '$check'
+                    . ') || ' . $all . ')'
+                    if defined $xs_type_name;
+
                 'do {'
                     . 'my $check = ' . $val . ';'
                     . 'ref($check) eq "HASH" '
-                        . '&& &List::Util::all('
-                            . 'sub { ' . $type_parameter->_inline_check('$_') . ' }, '
-                            . 'values %{$check}'
-                        . ')'
+                        . '&& ' . $all
                 . '}';
             },
         )
@@ -45,6 +45,22 @@ mop_check_package_cache_flag (pTHX_ HV *stash)
          : 0;
 }
 
+/* pkg_gen only changes with the stash's own methods and @ISA. Anything
+ * which can change the outcome of a method lookup or of isa on objects of
+ * the stash, including changes to its ancestors, changes what perl's own
+ * method cache is keyed on: PL_sub_generation plus the stash's cache_gen.
+ * Returns 0 until the stash has mro data, which perl creates the first time
+ * it looks at its linearized @ISA. */
+UV
+mop_stash_method_gen (pTHX_ HV *stash)
+{
+    assert(SvTYPE(stash) == SVt_PVHV);
+
+    return SvOOK(stash) && HvAUX(stash)->xhv_mro_meta
+         ? (UV)PL_sub_generation + HvAUX(stash)->xhv_mro_meta->cache_gen
+         : 0;
+}
+
 #else /* pre 5.10.0 */
 
 UV
@@ -55,6 +71,15 @@ mop_check_package_cache_flag (pTHX_ HV *stash)
 
     return PL_sub_generation;
 }
+
+UV
+mop_stash_method_gen (pTHX_ HV *stash)
+{
+    PERL_UNUSED_ARG(stash);
+    assert(SvTYPE(stash) == SVt_PVHV);
+
+    return PL_sub_generation;
+}
 #endif
 
 SV *
@@ -181,16 +206,14 @@ mop_get_all_package_symbols (HV *stash, type_filter_t filter)
     return ret;
 }
 
-#define DECLARE_KEY(name)                    { #name, #name, NULL, 0 }
-#define DECLARE_KEY_WITH_VALUE(name, value)  { #name, value, NULL, 0 }
+#define DECLARE_KEY(name)                    { #name, #name }
+#define DECLARE_KEY_WITH_VALUE(name, value)  { #name, value }
 
 /* the order of these has to match with those in mop.h */
-static struct {
+static const struct {
     const char *name;
     const char *value;
-    SV *key;
-    U32 hash;
-} prehashed_keys[key_last] = {
+} builtin_keys[key_last] = {
     DECLARE_KEY(_expected_method_class),
     DECLARE_KEY(ISA),
     DECLARE_KEY(VERSION),
@@ -227,6 +250,25 @@ static struct {
     DECLARE_KEY(operator)
 };
 
+/* the builtin keys above, followed by those registered at runtime with
+ * mop_prehash_key. the keys are shared hash key scalars, so looking them up
+ * in a hash needs neither hashing nor comparing strings. they live as long
+ * as the interpreter */
+typedef struct {
+    const char *name;
+    SV *key;
+    U32 hash;
+} prehashed_key_entry_t;
+
+static prehashed_key_entry_t *prehashed_keys;
+
+static I32 num_prehashed_keys;
+static I32 max_prehashed_keys;
+
+/* maps the names of keys registered at runtime to their index in
+ * prehashed_keys */
+static HV *registered_keys;
+
 SV *
 mop_prehashed_key_for (mop_prehashed_key_t key)
 {
@@ -239,15 +281,57 @@ mop_prehashed_hash_for (mop_prehashed_key_t key)
     return prehashed_keys[key].hash;
 }
 
+static mop_prehashed_key_t
+mop_add_prehashed_key (pTHX_ const char *name, const char *pv, I32 len)
+{
+    SV *key;
+
+    if (num_prehashed_keys == max_prehashed_keys) {
+        max_prehashed_keys = max_prehashed_keys ? max_prehashed_keys * 2 : 64;
+        Renew(prehashed_keys, max_prehashed_keys, prehashed_key_entry_t);
+    }
+
+    key = newSVpvn_share(pv, len, 0);
+
+    prehashed_keys[num_prehashed_keys].name = name ? name : SvPVX(key);
+    prehashed_keys[num_prehashed_keys].key  = key;
+    prehashed_keys[num_prehashed_keys].hash = SvSHARED_HASH(key);
+
+    return (mop_prehashed_key_t)num_prehashed_keys++;
+}
+
 void
 mop_prehash_keys ()
 {
+    dTHX;
     int i;
+
     for (i = 0; i < key_last; i++) {
-        const char *value = prehashed_keys[i].value;
-        prehashed_keys[i].key = newSVpv(value, strlen(value));
-        PERL_HASH(prehashed_keys[i].hash, value, strlen(value));
+        const char *value = builtin_keys[i].value;
+        (void)mop_add_prehashed_key(aTHX_ builtin_keys[i].name, value, strlen(value));
+    }
+
+    registered_keys = newHV();
+}
+
+/* returns the prehashed key for name, adding it to the table if it's not
+ * there yet. registering the same name twice gives the same key */
+mop_prehashed_key_t
+mop_prehash_key (pTHX_ SV *name)
+{
+    STRLEN len;
+    const char *pv = SvPV(name, len);
+    HE *he = hv_fetch_ent(registered_keys, name, 0, 0);
+    mop_prehashed_key_t key;
+
+    if (he) {
+        return (mop_prehashed_key_t)SvIV(HeVAL(he));
     }
+
+    key = mop_add_prehashed_key(aTHX_ NULL, pv, SvUTF8(name) ? -(I32)len : (I32)len);
+    (void)hv_store_ent(registered_keys, name, newSViv(key), 0);
+
+    return key;
 }
 
 XS_EXTERNAL(mop_xs_simple_reader)
@@ -282,3 +366,465 @@ XS_EXTERNAL(mop_xs_simple_reader)
     XSRETURN(1);
 }
 
+
+static int
+mop_free_slot_accessor (pTHX_ SV *sv, MAGIC *mg)
+{
+    mop_slot_accessor_t *accessor = (mop_slot_accessor_t *)mg->mg_ptr;
+    PERL_UNUSED_ARG(sv);
+
+    SvREFCNT_dec(accessor->fallback);
+    Safefree(accessor);
+
+    return 0;
+}
+
+static MGVTBL mop_slot_accessor_vtbl = {
+    NULL, /* get */
+    NULL, /* set */
+    NULL, /* len */
+    NULL, /* clear */
+    mop_free_slot_accessor, /* free */
+};
+
+SV *
+mop_new_slot_accessor (pTHX_ XSUBADDR_t xsub, SV *slot_name, SV *fallback)
+{
+    mop_slot_accessor_t *accessor;
+    CV *cv = newXS(NULL, xsub, __FILE__);
+    mop_prehashed_key_t key = mop_prehash_key(aTHX_ slot_name);
+
+    Newx(accessor, 1, mop_slot_accessor_t);
+    accessor->key      = mop_prehashed_key_for(key);
+    accessor->hash     = mop_prehashed_hash_for(key);
+    accessor->fallback = newSVsv(fallback);
+    accessor->tc       = MOP_TC_NONE;
+    accessor->maybe    = FALSE;
+
+    CvXSUBANY(cv).any_ptr = accessor;
+    sv_magicext((SV *)cv, NULL, PERL_MAGIC_ext, &mop_slot_accessor_vtbl, (char *)accessor, 0);
+
+    return newRV_noinc((SV *)cv);
+}
+
+/* re-dispatch the arguments of the currently running xsub to its perl
+ * implementation, leaving the results in place. returns the number of
+ * results, for XSRETURN */
+I32
+mop_call_fallback (pTHX_ SV *fallback, I32 ax)
+{
+    PUSHMARK(PL_stack_base + ax - 1);
+    (void)call_sv(fallback, GIMME_V);
+
+    return (I32)(PL_stack_sp - PL_stack_base) - ax + 1;
+}
+
+static const struct {
+    const char *name;
+    mop_builtin_tc_t tc;
+} builtin_tcs[] = {
+    { "Any",      MOP_TC_ANY      },
+    { "Item",     MOP_TC_ITEM     },
+    { "Undef",    MOP_TC_UNDEF    },
+    { "Defined",  MOP_TC_DEFINED  },
+    { "Bool",     MOP_TC_BOOL     },
+    { "Value",    MOP_TC_VALUE    },
+    { "Ref",      MOP_TC_REF      },
+    { "Str",      MOP_TC_STR      },
+    { "Num",      MOP_TC_NUM      },
+    { "Int",      MOP_TC_INT      },
+    { "CodeRef",  MOP_TC_CODEREF  },
+    { "ArrayRef", MOP_TC_ARRAYREF },
+    { "HashRef",  MOP_TC_HASHREF  },
+    { "Object",   MOP_TC_OBJECT   },
+    { "Maybe",    MOP_TC_ANY      },
+};
+
+/* maps the name of a builtin type, or of Maybe[] of one, to the check done
+ * by mop_check_builtin_tc. undef means no type constraint at all. returns
+ * FALSE for anything else */
+bool
+mop_parse_builtin_tc (pTHX_ SV *type_name, mop_builtin_tc_t *tc, bool *maybe)
+{
+    STRLEN len;
+    const char *name;
+    size_t i;
+
+    *tc    = MOP_TC_NONE;
+    *maybe = FALSE;
+
+    if (!SvOK(type_name)) {
+        return TRUE;
+    }
+
+    name = SvPV(type_name, len);
+
+    if (len > 7 && strnEQ(name, "Maybe[", 6) && name[len - 1] == ']') {
+        *maybe = TRUE;
+        name += 6;
+        len  -= 7;
+    }
+
+    for (i = 0; i < sizeof(builtin_tcs) / sizeof(builtin_tcs[0]); i++) {
+        if (strlen(builtin_tcs[i].name) == len && strnEQ(builtin_tcs[i].name, name, len)) {
+            *tc = builtin_tcs[i].tc;
+            return TRUE;
+        }
+    }
+
+    *tc = MOP_TC_UNSUPPORTED;
+    return FALSE;
+}
+
+/* like mop_new_slot_accessor, for writers checking the given type. returns
+ * NULL if the type isn't one we can check */
+SV *
+mop_new_checked_slot_accessor (pTHX_ XSUBADDR_t xsub, SV *slot_name, SV *fallback, SV *type_name)
+{
+    mop_builtin_tc_t tc;
+    bool maybe;
+    SV *rv;
+
+    if (!mop_parse_builtin_tc(aTHX_ type_name, &tc, &maybe)) {
+        return NULL;
+    }
+
+    rv = mop_new_slot_accessor(aTHX_ xsub, slot_name, fallback);
+    MOP_SLOT_ACCESSOR((CV *)SvRV(rv))->tc    = tc;
+    MOP_SLOT_ACCESSOR((CV *)SvRV(rv))->maybe = maybe;
+
+    return rv;
+}
+
+/* the strings the Num type constraint accepts, which are those matching
+ * /\A[+-]?(?=[0-9]|\.[0-9])[0-9]*(?:\.[0-9]+)?(?:[Ee][+-]?[0-9]+)?\z/ */
+static bool
+mop_looks_like_num (const char *p, STRLEN len)
+{
+    const char *end = p + len;
+
+    if (p < end && (*p == '+' || *p == '-')) {
+        p++;
+    }
+
+    if (!(p < end && (isDIGIT(*p) || (*p == '.' && p + 1 < end && isDIGIT(p[1]))))) {
+        return FALSE;
+    }
+
+    while (p < end && isDIGIT(*p)) {
+        p++;
+    }
+
+    if (p < end && *p == '.') {
+        if (!(++p < end && isDIGIT(*p))) {
+            return FALSE;
+        }
+        while (p < end && isDIGIT(*p)) {
+            p++;
+        }
+    }
+
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        if (++p < end && (*p == '+' || *p == '-')) {
+            p++;
+        }
+        if (!(p < end && isDIGIT(*p))) {
+            return FALSE;
+        }
+        while (p < end && isDIGIT(*p)) {
+            p++;
+        }
+    }
+
+    return p == end;
+}
+
+/* and the ones /\A-?[0-9]+\z/ accepts */
+static bool
+mop_looks_like_int (const char *p, STRLEN len)
+{
+    const char *end = p + len;
+
+    if (p < end && *p == '-') {
+        p++;
+    }
+
+    if (p == end) {
+        return FALSE;
+    }
+
+    while (p < end && isDIGIT(*p)) {
+        p++;
+    }
+
+    return p == end;
+}
+
+/* whether a value passes the Num (or Int) type constraint, which matches the
+ * string form of any defined non-reference against the regexes above. we
+ * only need to look at that string when the value doesn't already hold a
+ * plain number, and never stringify the value itself */
+bool
+mop_is_num (pTHX_ SV *value, bool integer)
+{
+    STRLEN len;
+    const char *pv;
+    SV *copy;
+
+    if (!SvOK(value) || SvROK(value)) {
+        return FALSE;
+    }
+
+    if (SvTYPE(value) <= SVt_PVMG) {
+        if (SvPOK(value)) {
+            pv = SvPV_nomg(value, len);
+            return integer ? mop_looks_like_int(pv, len) : mop_looks_like_num(pv, len);
+        }
+
+        /* integers stringify as an optional minus sign and some digits */
+        if (SvIOK(value)) {
+            return TRUE;
+        }
+
+        /* a finite NV stringifies as something like 1.5 or 1e+20, but inf
+         * and nan don't pass (inf - inf is nan, nan != anything). integral
+         * NVs can still stringify with an exponent, so those need a look */
+        if (!integer && SvNOK(value)) {
+            return SvNVX(value) - SvNVX(value) == 0.0;
+        }
+    }
+
+    /* globs, NVs for Int and other oddities: stringify a copy, like the
+     * perl code does */
+    copy = sv_newmortal();
+    sv_setsv_flags(copy, value, 0);
+    pv = SvPV_nomg(copy, len);
+    return integer ? mop_looks_like_int(pv, len) : mop_looks_like_num(pv, len);
+}
+
+/* true for objects, except those blessed into a package whose name is
+ * false, for which blessed() and ref() lie */
+bool
+mop_is_sane_object (pTHX_ SV *rv)
+{
+    const char *name;
+
+    if (!SvOBJECT(rv)) {
+        return FALSE;
+    }
+
+    name = HvNAME_get(SvSTASH(rv));
+
+    return name && !(name[0] == '\0' || (name[0] == '0' && name[1] == '\0'));
+}
+
+/* a plain scalar, the only thing Str accepts, rather than a glob, a vstring
+ * or some other exotic thing */
+#define MOP_IS_PLAIN_SCALAR(sv) \
+    (SvOK(sv) && !SvROK(sv) && SvTYPE(sv) <= SVt_PVMG && !SvVOK(sv))
+
+/* returns TRUE if value definitely passes the given builtin type constraint
+ * (or is undef, for Maybe). FALSE means either that it doesn't, or that it's
+ * unusual enough for us to let the perl implementation decide (magic, globs,
+ * plain NVs for Int, ...) */
+bool
+mop_check_builtin_tc (pTHX_ mop_builtin_tc_t tc, bool maybe, SV *value)
+{
+    STRLEN len;
+    const char *pv;
+
+    if (tc == MOP_TC_NONE || tc == MOP_TC_ANY || tc == MOP_TC_ITEM) {
+        return TRUE;
+    }
+
+    if (SvGMAGICAL(value)) {
+        return FALSE;
+    }
+
+    if (maybe && !SvOK(value)) {
+        return TRUE;
+    }
+
+    switch (tc) {
+        case MOP_TC_UNDEF:
+            return !SvOK(value);
+        case MOP_TC_DEFINED:
+            return SvOK(value);
+        case MOP_TC_BOOL:
+            if (!SvOK(value)) {
+                return TRUE;
+            }
+            if (SvROK(value)) {
+                return FALSE;
+            }
+            if (SvPOK(value)) {
+                pv = SvPV_nomg(value, len);
+                return len == 0 || (len == 1 && (pv[0] == '0' || pv[0] == '1'));
+            }
+            return SvIOK(value) && !SvNOK(value) && !SvIsUV(value)
+                && (SvIVX(value) == 0 || SvIVX(value) == 1);
+        case MOP_TC_VALUE:
+            return SvOK(value) && !SvROK(value);
+        case MOP_TC_REF:
+            return SvROK(value) && (!SvOBJECT(SvRV(value)) || mop_is_sane_object(aTHX_ SvRV(value)));
+        case MOP_TC_STR:
+            return MOP_IS_PLAIN_SCALAR(value);
+        case MOP_TC_NUM:
+            return mop_is_num(aTHX_ value, FALSE);
+        case MOP_TC_INT:
+            return mop_is_num(aTHX_ value, TRUE);
+        case MOP_TC_CODEREF:
+            return SvROK(value) && !SvOBJECT(SvRV(value)) && SvTYPE(SvRV(value)) == SVt_PVCV;
+        case MOP_TC_ARRAYREF:
+            return SvROK(value) && !SvOBJECT(SvRV(value)) && SvTYPE(SvRV(value)) == SVt_PVAV;
+        case MOP_TC_HASHREF:
+            return SvROK(value) && !SvOBJECT(SvRV(value)) && SvTYPE(SvRV(value)) == SVt_PVHV;
+        case MOP_TC_OBJECT:
+            return SvROK(value) && mop_is_sane_object(aTHX_ SvRV(value));
+        default:
+            return FALSE;
+    }
+}
+
+/* the instance an accessor was called on, if it's a plain hash based one */
+HV *
+mop_slot_instance (pTHX_ SV *self)
+{
+    HV *obj;
+
+    if (!SvROK(self)) {
+        return NULL;
+    }
+
+    obj = (HV *)SvRV(self);
+
+    return SvTYPE(obj) == SVt_PVHV && !SvRMAGICAL(obj) ? obj : NULL;
+}
+
+/* a copy of the value in the slot, so that aliasing the return value (as
+ * for() and map do) can't change the object behind the accessor's back */
+static SV *
+mop_fetch_slot (pTHX_ mop_slot_accessor_t *accessor, HV *obj)
+{
+    HE *he = hv_fetch_ent(obj, accessor->key, 0, accessor->hash);
+
+    return he ? sv_mortalcopy(HeVAL(he)) : &PL_sv_undef;
+}
+
+/* assigns to the slot the way $self->{slot} = $value would, after checking
+ * the type constraint, and returns a copy of the stored value. returns NULL
+ * if the value has to go through perl */
+static SV *
+mop_store_slot (pTHX_ mop_slot_accessor_t *accessor, HV *obj, SV *value)
+{
+    HE *he;
+
+    if (!mop_check_builtin_tc(aTHX_ accessor->tc, accessor->maybe, value)) {
+        return NULL;
+    }
+
+    he = hv_fetch_ent(obj, accessor->key, 1, accessor->hash);
+    sv_setsv_mg(HeVAL(he), value);
+
+    return sv_mortalcopy(HeVAL(he));
+}
+
+/* assignment attempts, class method calls and tied or otherwise magical
+ * instances all get the exact behaviour of the generated perl code, as do
+ * values which fail the type constraint */
+
+XS_EXTERNAL(mop_xs_slot_reader)
+{
+    dVAR;
+    dXSARGS;
+    mop_slot_accessor_t *accessor = MOP_SLOT_ACCESSOR(cv);
+    HV *obj;
+
+    if (items != 1 || !(obj = mop_slot_instance(aTHX_ ST(0)))) {
+        XSRETURN(mop_call_fallback(aTHX_ accessor->fallback, ax));
+    }
+
+    ST(0) = mop_fetch_slot(aTHX_ accessor, obj);
+    XSRETURN(1);
+}
+
+XS_EXTERNAL(mop_xs_slot_writer)
+{
+    dVAR;
+    dXSARGS;
+    mop_slot_accessor_t *accessor = MOP_SLOT_ACCESSOR(cv);
+    HV *obj;
+    SV *stored;
+
+    if (items != 2 || !(obj = mop_slot_instance(aTHX_ ST(0)))
+     || !(stored = mop_store_slot(aTHX_ accessor, obj, ST(1)))) {
+        XSRETURN(mop_call_fallback(aTHX_ accessor->fallback, ax));
+    }
+
+    ST(0) = stored;
+    XSRETURN(1);
+}
+
+XS_EXTERNAL(mop_xs_slot_accessor)
+{
+    dVAR;
+    dXSARGS;
+    mop_slot_accessor_t *accessor = MOP_SLOT_ACCESSOR(cv);
+    HV *obj;
+    SV *stored;
+
+    if (items == 1 && (obj = mop_slot_instance(aTHX_ ST(0)))) {
+        ST(0) = mop_fetch_slot(aTHX_ accessor, obj);
+        XSRETURN(1);
+    }
+
+    if (items == 2 && (obj = mop_slot_instance(aTHX_ ST(0)))
+     && (stored = mop_store_slot(aTHX_ accessor, obj, ST(1)))) {
+        ST(0) = stored;
+        XSRETURN(1);
+    }
+
+    XSRETURN(mop_call_fallback(aTHX_ accessor->fallback, ax));
+}
+
+/* what Moose::Object::BUILDARGS returns for these arguments, as a mortal hash
+ * reference. returns NULL if a single argument isn't a hash reference, and
+ * sets *odd if an odd length list had to be padded with undef, leaving the
+ * exception and the warning to the caller */
+SV *
+mop_buildargs (pTHX_ SV **args, I32 nargs, bool *odd)
+{
+    HV *params = newHV();
+    SV *ret = sv_2mortal(newRV_noinc((SV *)params));
+    I32 i;
+
+    *odd = FALSE;
+
+    if (nargs == 1) {
+        SV *arg = args[0];
+        HV *src;
+        HE *he;
+
+        SvGETMAGIC(arg);
+        if (!SvROK(arg) || SvTYPE(SvRV(arg)) != SVt_PVHV
+         || !strEQ(sv_reftype(SvRV(arg), TRUE), "HASH")) {
+            return NULL;
+        }
+
+        src = (HV *)SvRV(arg);
+        (void)hv_iterinit(src);
+        while ((he = hv_iternext(src))) {
+            (void)hv_store_ent(params, hv_iterkeysv(he), newSVsv(hv_iterval(src, he)), 0);
+        }
+
+        return ret;
+    }
+
+    for (i = 0; i < nargs; i += 2) {
+        (void)hv_store_ent(params, args[i], i + 1 < nargs ? newSVsv(args[i + 1]) : newSV(0), 0);
+    }
+
+    *odd = nargs % 2;
+
+    return ret;
+}
@@ -66,6 +66,7 @@ typedef enum {
 #define HASH_FOR(name) mop_prehashed_hash_for(KEY_ ##name)
 
 void mop_prehash_keys (void);
+mop_prehashed_key_t mop_prehash_key (pTHX_ SV *name);
 SV *mop_prehashed_key_for (mop_prehashed_key_t key);
 U32 mop_prehashed_hash_for (mop_prehashed_key_t key);
 
@@ -78,11 +79,61 @@ U32 mop_prehashed_hash_for (mop_prehashed_key_t key);
 
 XS_EXTERNAL(mop_xs_simple_reader);
 
+/* the builtin type constraints which writers can check without calling back
+ * into perl; see Moose::Util::TypeConstraints::Builtins for their meaning */
+typedef enum {
+    MOP_TC_NONE,
+    MOP_TC_ANY,
+    MOP_TC_ITEM,
+    MOP_TC_UNDEF,
+    MOP_TC_DEFINED,
+    MOP_TC_BOOL,
+    MOP_TC_VALUE,
+    MOP_TC_REF,
+    MOP_TC_STR,
+    MOP_TC_NUM,
+    MOP_TC_INT,
+    MOP_TC_CODEREF,
+    MOP_TC_ARRAYREF,
+    MOP_TC_HASHREF,
+    MOP_TC_OBJECT,
+    MOP_TC_UNSUPPORTED,
+} mop_builtin_tc_t;
+
+/* per-CV data for the C accessors generated for user attributes; a pointer
+ * to this lives in CvXSUBANY(cv).any_ptr and is freed along with the CV */
+typedef struct {
+    SV  *key;       /* prehashed key for the slot */
+    U32  hash;      /* its precomputed hash */
+    SV  *fallback;  /* the perl implementation, for anything unusual */
+    mop_builtin_tc_t tc;    /* constraint checked by writers */
+    bool maybe;             /* whether undef is also allowed (Maybe[...]) */
+} mop_slot_accessor_t;
+
+#define MOP_SLOT_ACCESSOR(cv)  ((mop_slot_accessor_t *)CvXSUBANY(cv).any_ptr)
+
+SV *mop_new_slot_accessor(pTHX_ XSUBADDR_t xsub, SV *slot_name, SV *fallback);
+HV *mop_slot_instance(pTHX_ SV *self);
+I32 mop_call_fallback(pTHX_ SV *fallback, I32 ax);
+
+bool mop_parse_builtin_tc(pTHX_ SV *type_name, mop_builtin_tc_t *tc, bool *maybe);
+SV *mop_new_checked_slot_accessor(pTHX_ XSUBADDR_t xsub, SV *slot_name, SV *fallback, SV *type_name);
+bool mop_check_builtin_tc(pTHX_ mop_builtin_tc_t tc, bool maybe, SV *value);
+bool mop_is_sane_object(pTHX_ SV *rv);
+bool mop_is_num(pTHX_ SV *value, bool integer);
+
+SV *mop_buildargs(pTHX_ SV **args, I32 nargs, bool *odd);
+
+XS_EXTERNAL(mop_xs_slot_reader);
+XS_EXTERNAL(mop_xs_slot_writer);
+XS_EXTERNAL(mop_xs_slot_accessor);
+
 extern SV *mop_method_metaclass;
 extern SV *mop_associated_metaclass;
 extern SV *mop_wrap;
 
 UV mop_check_package_cache_flag(pTHX_ HV *stash);
+UV mop_stash_method_gen(pTHX_ HV *stash);
 int mop_get_code_info (SV *coderef, char **pkg, char **name);
 SV *mop_call0(pTHX_ SV *const self, SV *const method);
 
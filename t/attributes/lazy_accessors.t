@@ -0,0 +1,117 @@
+use strict;
+use warnings;
+
+use Test::More;
+use Test::Fatal;
+
+use Scalar::Util 'weaken';
+
+BEGIN { $ENV{MOOSE_LAZY_ACCESSORS} = 1 }
+
+{
+    package Bar;
+    sub new   { bless {}, shift }
+    sub hello {'hello'}
+
+    package Foo;
+    use Moose;
+
+    has x => (
+        is        => 'rw',
+        isa       => 'Int',
+        predicate => 'has_x',
+        clearer   => 'clear_x',
+    );
+
+    has list => (
+        traits  => ['Array'],
+        is      => 'ro',
+        isa     => 'ArrayRef',
+        default => sub { [] },
+        handles => { count => 'count', add => 'push' },
+    );
+
+    has bar => (
+        is      => 'ro',
+        default => sub { Bar->new },
+        handles => ['hello'],
+    );
+}
+
+my %stubs = map { $_ => Foo->can($_) } qw( x has_x clear_x count add hello );
+
+# brings the method map up to date
+Foo->meta->get_method_list;
+
+my $foo = Foo->new( x => 1 );
+
+is( $foo->x, 1, 'reader' );
+ok( $foo->has_x, 'predicate' );
+$foo->clear_x;
+ok( !$foo->has_x, 'clearer' );
+$foo->add( 1, 2 );
+is( $foo->count, 2, 'native delegations' );
+is( $foo->hello, 'hello', 'delegation' );
+
+like(
+    exception { $foo->x('foo') },
+    qr/Attribute \(x\) does not pass the type constraint/,
+    'the type is checked'
+);
+
+is(
+    Foo->meta->{_package_cache_flag},
+    mro::get_pkg_gen('Foo'),
+    'replacing the stubs does not make the method map stale'
+);
+
+for my $name ( sort keys %stubs ) {
+    my $code = Foo->can($name);
+    isnt( $code, $stubs{$name}, "$name is compiled when first called" );
+    is( Foo->meta->get_method($name)->body, $code, '... and is the body of the method' );
+    is_deeply(
+        [ Class::MOP::get_code_info($code) ],
+        [ 'Foo', $name ],
+        '... which has the right name'
+    );
+}
+
+{
+    package Baz;
+    use Moose;
+    has y => ( is => 'rw', predicate => 'has_y' );
+}
+
+my $stub = Baz->can('y');
+my $baz  = Baz->new( y => 2 );
+is( $stub->($baz), 2, 'a stub called through a reference taken earlier' );
+is( $stub->($baz), 2, '... keeps working' );
+isnt( Baz->can('y'), $stub, '... and has been replaced in the class' );
+
+Baz->meta->make_immutable;
+ok( Baz->new( y => 3 )->has_y, 'stub of an immutable class' );
+
+my $anon = Moose::Meta::Class->create_anon_class(
+    superclasses => ['Moose::Object'],
+    attributes   => [ Moose::Meta::Attribute->new( z => ( is => 'ro' ) ) ],
+);
+my $anon_reader = $anon->name->can('z');
+my $anon_method = $anon->get_method('z');
+weaken($anon_reader);
+weaken($anon_method);
+is( $anon->new_object( z => 4 )->z, 4, 'accessor of an anonymous class' );
+isnt( $anon->name->can('z'), $anon_reader, '... is lazy' );
+
+my $unused = Moose::Meta::Class->create_anon_class(
+    superclasses => ['Moose::Object'],
+    attributes   => [ Moose::Meta::Attribute->new( z => ( is => 'ro' ) ) ],
+);
+my $unused_stub = $unused->name->can('z');
+my $unused_method = $unused->get_method('z');
+weaken($unused_stub);
+weaken($unused_method);
+undef $unused;
+ok( !$unused_stub, 'a stub never called is freed with its anonymous class' );
+ok( !$unused_method, '... and so is its method' );
+
+done_testing;
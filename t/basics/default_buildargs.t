@@ -0,0 +1,103 @@
+use strict;
+use warnings;
+
+use Test::More;
+use Test::Fatal;
+use Test::Moose qw( with_immutable );
+
+{
+    package Foo;
+    use Moose;
+
+    has bar => ( is => 'rw' );
+    has baz => ( is => 'rw' );
+}
+
+{
+    package Bar;
+    use Moose;
+    extends 'Foo';
+
+    sub BUILDARGS {
+        my $class = shift;
+        my $params = $class->SUPER::BUILDARGS(@_);
+        $params->{baz} = 'from Bar';
+        return $params;
+    }
+}
+
+{
+    package Tied;
+    require Tie::Hash;
+    our @ISA = 'Tie::StdHash';
+}
+
+{
+    is_deeply( Foo->BUILDARGS, {}, 'no args' );
+    is_deeply(
+        Foo->BUILDARGS( bar => 1, baz => 2, bar => 3 ),
+        { bar => 3, baz => 2 },
+        'key/value list, later keys win'
+    );
+
+    my $value  = [];
+    my $params = { bar => $value };
+    my $copy   = Foo->BUILDARGS($params);
+    is_deeply( $copy, $params, 'hash ref' );
+    isnt( $copy, $params, '... is copied' );
+    is( $copy->{bar}, $value, '... but not deeply' );
+
+    my @list = ( bar => 1 );
+    Foo->BUILDARGS(@list)->{bar} = 2;
+    is( $list[1], 1, 'values from a list are copied' );
+
+    tie my %tied, 'Tied';
+    %tied = ( bar => 42 );
+    is_deeply( Foo->BUILDARGS( \%tied ), { bar => 42 }, 'tied hash ref' );
+
+    is_deeply(
+        Foo->BUILDARGS( bless { bar => 1 }, 'HASH' ),
+        { bar => 1 },
+        'anything ref() calls a HASH is accepted'
+    );
+}
+
+{
+    my @warnings;
+    local $SIG{__WARN__} = sub { push @warnings, @_ };
+
+    is_deeply(
+        Foo->BUILDARGS( bar => 1, 'baz' ),
+        { bar => 1, baz => undef },
+        'odd number of arguments'
+    );
+    is( scalar @warnings, 1, '... warns once' );
+    like(
+        $warnings[0],
+        qr/\QThe new() method for Foo expects a hash reference or a key\/value list. You passed an odd number of arguments at $0 line/,
+        '... from the caller'
+    );
+}
+
+for my $arg ( undef, 42, [], sub {}, \'scalar', bless( {}, 'Foo' ) ) {
+    my $desc = defined $arg ? ( ref $arg || $arg ) : 'undef';
+    like(
+        exception { Foo->BUILDARGS($arg) },
+        qr/\QSingle parameters to new() must be a HASH ref at $0 line/,
+        "single $desc argument"
+    );
+}
+
+with_immutable {
+    my $foo = Foo->new( bar => 1, baz => 2 );
+    is( $foo->bar, 1, 'new with a list' );
+    is( $foo->baz, 2, '... sets both attributes' );
+    is( Foo->new( { bar => 3 } )->bar, 3, 'new with a hash ref' );
+
+    my $bar = Bar->new( bar => 4 );
+    is( $bar->bar, 4, 'BUILDARGS calling SUPER::BUILDARGS' );
+    is( $bar->baz, 'from Bar', '... can change its result' );
+}
+qw( Foo Bar );
+
+done_testing;
@@ -0,0 +1,75 @@
+use strict;
+use warnings;
+
+use Test::More;
+use Test::Moose qw( with_immutable );
+
+my @demolished;
+
+{
+    package Foo;
+    use Moose;
+
+    has die_with => ( is => 'ro' );
+
+    sub DEMOLISH {
+        my ( $self, $igd ) = @_;
+        push @demolished, [ 'Foo', $@, $igd ];
+        eval { 1 };
+        die $self->die_with if defined $self->die_with;
+    }
+}
+
+{
+    package Bar;
+    use Moose;
+    extends 'Foo';
+
+    sub DEMOLISH { push @demolished, ['Bar'] }
+}
+
+with_immutable {
+    my $kind = Foo->meta->is_immutable ? 'immutable' : 'mutable';
+
+    @demolished = ();
+    {
+        local $@ = 'previous';
+        my $foo = Foo->new;
+        undef $foo;
+        is( $@, 'previous', "$kind: \$\@ survives DEMOLISH" );
+    }
+    is_deeply(
+        \@demolished, [ [ 'Foo', 'previous', '' ] ],
+        "$kind: DEMOLISH sees \$\@ and is not in global destruction"
+    );
+
+    eval {
+        my $foo = Foo->new;
+        die "thrown\n";
+    };
+    is( $@, "thrown\n", "$kind: an eval in DEMOLISH doesn't eat the exception" );
+
+    my @warnings;
+    {
+        local $SIG{__WARN__} = sub { push @warnings, @_ };
+        my $foo = Foo->new( die_with => "from DEMOLISH\n" );
+        undef $foo;
+    }
+    is( scalar @warnings, 1, "$kind: one warning for an exception in DEMOLISH" );
+    like(
+        $warnings[0],
+        qr/\(in cleanup\) from DEMOLISH/,
+        "$kind: ... which is rethrown"
+    );
+
+    @demolished = ();
+    my $bar = Bar->new;
+    undef $bar;
+    is_deeply(
+        [ map { $_->[0] } @demolished ], [ 'Bar', 'Foo' ],
+        "$kind: DEMOLISH methods are called from the most derived class"
+    );
+}
+qw( Foo Bar );
+
+done_testing;
@@ -0,0 +1,143 @@
+use strict;
+use warnings;
+
+use Test::More;
+use Test::Fatal;
+
+use Scalar::Util 'reftype';
+use Class::MOP;
+use Class::MOP::Instance::Array;
+
+{
+    package Foo;
+    use metaclass 'Class::MOP::Class' => (
+        instance_metaclass => 'Class::MOP::Instance::Array',
+    );
+
+    Foo->meta->add_attribute( foo => ( accessor => 'foo', predicate => 'has_foo', clearer => 'clear_foo' ) );
+    Foo->meta->add_attribute( bar => ( accessor => 'bar', default => 'BAR' ) );
+
+    sub new { shift->meta->new_object(@_) }
+}
+
+{
+    package Bar;
+    use parent -norequire => 'Foo';
+    use metaclass 'Class::MOP::Class' => (
+        instance_metaclass => 'Class::MOP::Instance::Array',
+    );
+
+    Bar->meta->add_attribute( baz => ( accessor => 'baz' ) );
+}
+
+{
+    package HashBased;
+    use metaclass;
+
+    HashBased->meta->add_attribute( hash => ( accessor => 'hash' ) );
+}
+
+{
+    package OtherParent;
+    use metaclass 'Class::MOP::Class' => (
+        instance_metaclass => 'Class::MOP::Instance::Array',
+    );
+
+    OtherParent->meta->add_attribute( other => ( accessor => 'other' ) );
+}
+
+my $foo_mi = Foo->meta->get_meta_instance;
+my $bar_mi = Bar->meta->get_meta_instance;
+
+is_deeply( $foo_mi->get_slot_index_map, { foo => 1, bar => 2 }, 'Foo layout' );
+is_deeply(
+    $bar_mi->get_slot_index_map, { foo => 1, bar => 2, baz => 3 },
+    'Bar starts with the layout of Foo'
+);
+is( $bar_mi->inline_slot_access( '$self', 'baz' ), '$self->[3]', 'inlined access uses the index' );
+like(
+    exception { $bar_mi->get_slot_index('nope') },
+    qr/\QThe slot 'nope' is not part of the instance layout of Bar/,
+    'unknown slot'
+);
+
+for my $immutable ( 0, 1 ) {
+    my $bar = Bar->new( foo => 1, baz => 3 );
+    is( reftype($bar), 'ARRAY', 'instances are arrays' );
+    is_deeply( [ @{$bar} ], [ undef, 1, 'BAR', 3 ], '... with the slots in order' );
+    is( $bar->foo, 1, 'inherited accessor' );
+    is( $bar->baz, 3, 'own accessor' );
+
+    ok( $bar->has_foo, 'predicate' );
+    $bar->clear_foo;
+    ok( !$bar->has_foo, '... after the clearer' );
+    ok( !$bar_mi->is_slot_initialized( $bar, 'foo' ), 'is_slot_initialized' );
+
+    my $ref = [];
+    $bar_mi->set_slot_value( $bar, baz => $ref );
+    $bar_mi->weaken_slot_value( $bar, 'baz' );
+    ok( $bar_mi->slot_value_is_weak( $bar, 'baz' ), 'weak slot' );
+    undef $ref;
+    is( $bar->baz, undef, '... is weak' );
+
+    my $clone = Bar->meta->clone_object( $bar, foo => 2 );
+    is_deeply( [ @{$clone} ], [ undef, 2, 'BAR', undef ], 'clone_object' );
+
+    Foo->meta->make_immutable( inline_constructor => 0 );
+    Bar->meta->make_immutable;
+}
+
+{
+    my $anon = Class::MOP::Class->create_anon_class(
+        superclasses       => ['Foo'],
+        instance_metaclass => 'Class::MOP::Instance::Array',
+    );
+    my $obj = $anon->new_object( foo => 1 );
+    is( $obj->foo, 1, 'anon class' );
+    ok( $anon->get_meta_instance->_has_mop_slot($obj), '... keeps its metaclass in slot 0' );
+}
+
+{
+    package Baz;
+    use metaclass 'Class::MOP::Class' => (
+        instance_metaclass => 'Class::MOP::Instance::Array',
+    );
+    Baz->meta->add_attribute( b => ( accessor => 'b' ) );
+    Baz->meta->add_attribute( a => ( accessor => 'a' ) );
+}
+
+is_deeply(
+    Baz->meta->get_meta_instance->get_slot_index_map, { b => 1, a => 2 },
+    'slots are in the order their attributes were added'
+);
+Baz->meta->add_attribute( c => ( accessor => 'c' ) );
+is_deeply(
+    Baz->meta->get_meta_instance->get_slot_index_map, { b => 1, a => 2, c => 3 },
+    '... so adding one leaves the others in place'
+);
+
+like(
+    exception {
+        Class::MOP::Class->create(
+            'FromHash',
+            superclasses       => ['HashBased'],
+            instance_metaclass => 'Class::MOP::Instance::Array',
+        )->get_meta_instance;
+    },
+    qr/\QInstances of FromHash are stored in arrays, so the instances of its superclass HashBased must be stored in arrays too/,
+    'superclass stored in a hash'
+);
+
+like(
+    exception {
+        Class::MOP::Class->create(
+            'Diamond',
+            superclasses       => [ 'Foo', 'OtherParent' ],
+            instance_metaclass => 'Class::MOP::Instance::Array',
+        )->get_meta_instance;
+    },
+    qr/\QThe slot 'other' of OtherParent cannot be stored at the same array index in instances of Diamond/,
+    'superclasses with overlapping layouts'
+);
+
+done_testing;
@@ -0,0 +1,103 @@
+use strict;
+use warnings;
+
+use Test::More;
+
+use Class::MOP;
+
+my $base   = Class::MOP::Class->create('Base');
+my $middle = Class::MOP::Class->create( 'Middle', superclasses => ['Base'] );
+my $leaf   = Class::MOP::Class->create( 'Leaf', superclasses => ['Middle'] );
+my $other  = Class::MOP::Class->create('Other');
+
+sub attrs   { join ' ', sort map { $_->name } $_[0]->get_all_attributes }
+sub methods { join ' ', sort grep { !/^(?:DOES|VERSION|can|isa|meta|import|unimport)$/ } map { $_->name } $_[0]->get_all_methods }
+
+$base->add_attribute('base_attr');
+is( attrs($leaf), 'base_attr', 'attributes of superclasses' );
+
+$middle->add_attribute('middle_attr');
+is( attrs($leaf), 'base_attr middle_attr', 'attribute added to a superclass' );
+ok( $leaf->find_attribute_by_name('middle_attr'), '... is found by name' );
+
+$base->add_attribute( 'middle_attr', default => 1 );
+is(
+    $leaf->find_attribute_by_name('middle_attr')->associated_class->name,
+    'Middle',
+    'the closest class wins'
+);
+
+$middle->remove_attribute('middle_attr');
+is( $leaf->find_attribute_by_name('middle_attr')->associated_class->name, 'Base', 'attribute removed' );
+
+$other->add_attribute('other_attr');
+$leaf->superclasses('Other');
+is( attrs($leaf), 'other_attr', 'changing superclasses' );
+
+$leaf->superclasses('Middle');
+is( attrs($leaf), 'base_attr middle_attr', '... and back' );
+
+$base->add_method( base_method => sub {'base'} );
+is( methods($leaf), 'base_method', 'methods of superclasses' );
+
+$middle->add_method( middle_method => sub {'middle'} );
+is( methods($leaf), 'base_method middle_method', 'method added to a superclass' );
+
+{
+    no strict 'refs';
+    *{'Base::from_glob'} = Sub::Util::set_subname( 'Base::from_glob', sub {'glob'} );
+}
+is( methods($leaf), 'base_method from_glob middle_method', 'method added to the package directly' );
+
+$middle->add_method( base_method => sub {'overridden'} );
+is(
+    join( ' ', map { $_->{class} } $leaf->find_all_methods_by_name('base_method') ),
+    'Middle Base',
+    'find_all_methods_by_name'
+);
+
+my ($found) = $leaf->find_all_methods_by_name('base_method');
+$found->{class} = 'Changed';
+is(
+    ( $leaf->find_all_methods_by_name('base_method') )[0]{class},
+    'Middle',
+    '... returns copies'
+);
+
+$middle->remove_method('base_method');
+is(
+    join( ' ', map { $_->{class} } $leaf->find_all_methods_by_name('base_method') ),
+    'Base',
+    '... notices removed methods'
+);
+
+Class::MOP::remove_metaclass_by_name('Base');
+my $new_base = Class::MOP::Class->initialize('Base');
+$new_base->add_method( base_method => sub {'new'} );
+is(
+    ( grep { $_->name eq 'base_method' } $leaf->get_all_methods )[0]->associated_metaclass,
+    $new_base,
+    'new metaclass of a superclass'
+);
+is( attrs($leaf), '', '... without the attributes of the old one' );
+
+{
+    $leaf->get_all_methods;
+    my $entry = $leaf->{_cached_over_classes}{all_methods};
+
+    ok(
+        !grep( { !Scalar::Util::isweak($_) } @{ $entry->{metas} } ),
+        'the cache holds the metaclasses weakly'
+    );
+
+    Class::MOP::remove_metaclass_by_name('Middle');
+    Class::MOP::Class->initialize('Middle');
+    $leaf->get_all_methods;
+    isnt(
+        $leaf->{_cached_over_classes}{all_methods},
+        $entry,
+        '... and notices when one is replaced by a new one'
+    );
+}
+
+done_testing;
@@ -0,0 +1,43 @@
+use strict;
+use warnings;
+use utf8;
+
+use Test::More;
+
+use Class::MOP;
+
+{
+    package Big;
+    no strict 'refs';
+    *{"method_$_"} = eval "sub { $_ }" for 1 .. 300;
+    sub stubbed;
+    use constant CONSTANT => 42;
+}
+
+my $meta = Class::MOP::Class->initialize('Big');
+
+is( scalar $meta->get_method_list, 302, 'all methods are found' );
+is( $meta->get_method('method_7')->body->(), 7, '... with the right bodies' );
+
+eval q{ package Big; sub added {'added'} };
+ok( $meta->has_method('added'), 'method added to the package is found' );
+is( $meta->get_method('method_7')->body->(), 7, '... and the others are kept' );
+
+eval q{ package Big; no warnings 'redefine'; sub method_8 {'replaced'} };
+is( $meta->get_method('method_8')->body->(), 'replaced', 'replaced method is noticed' );
+
+delete $Big::{method_9};
+ok( !$meta->has_method('method_9'), 'method deleted from the package is dropped' );
+
+$meta->add_method( 'método' => sub {'utf8'} );
+is( $meta->get_method('método')->body->(), 'utf8', 'method with a utf8 name' );
+eval q{ package Big; sub other {'other'} };
+ok( $meta->has_method('método'), '... is kept after the package changes' );
+
+ok( $meta->has_method('stubbed'),  'stub is a method' );
+ok( $meta->has_method('CONSTANT'), 'constant is a method' );
+eval q{ package Big; sub another {'another'} };
+ok( $meta->has_method('stubbed'),  'stub is still a method after a refresh' );
+ok( $meta->has_method('CONSTANT'), '... as is the constant' );
+
+done_testing;
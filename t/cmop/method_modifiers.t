@@ -229,4 +229,100 @@ use Class::MOP::Method;
     ::note($msg);
 }
 
+# the wrapped method is recompiled as modifiers get added
+{
+    my ( @calls, $seen );
+
+    package Ctx;
+    our @ISA = ('Class::MOP::Object');
+
+    sub context {
+        push @calls, 'orig';
+        return $seen = wantarray ? 'list' : defined wantarray ? 'scalar' : 'void';
+    }
+
+    my $meta = Class::MOP::Class->initialize(__PACKAGE__);
+    my $context;
+
+    my @kinds = (
+        [ before  => sub { push @calls, 'before' } ],
+        [ after   => sub { push @calls, 'after' } ],
+        [ around  => sub { my $orig = shift; push @calls, 'around'; $orig->(@_) } ],
+        [ before2 => sub { push @calls, 'before2' } ],
+        [ around2 => sub { my $orig = shift; push @calls, 'around2'; $orig->(@_) } ],
+        [ after2  => sub { push @calls, 'after2' } ],
+    );
+
+    my %added = ( before => [], around => [], after => [] );
+    for my $kind (@kinds) {
+        my ( $name, $modifier ) = @{$kind};
+        ( my $type = $name ) =~ s/2$//;
+        my $add = "add_${type}_method_modifier";
+        $meta->$add( context => $modifier );
+        $context ||= \&Ctx::context;
+
+        if ( $type eq 'after' ) {
+            push @{ $added{$type} }, $name;
+        }
+        else {
+            unshift @{ $added{$type} }, $name;
+        }
+        my @expect = (
+            @{ $added{before} }, @{ $added{around} }, 'orig', @{ $added{after} }
+        );
+
+        @calls = ();
+        my @list = Ctx->context;
+        ::is( $list[0], 'list', "list context is passed through after adding $name" );
+        ::is_deeply( \@calls, \@expect, '... and the modifiers run in order' );
+
+        my $scalar = Ctx->context;
+        ::is( $scalar, 'scalar', '... as is scalar context' );
+
+        Ctx->context;
+        ::is( $seen, 'void', '... and void context' );
+
+        @calls = ();
+        $context->('Ctx');
+        ::is_deeply( \@calls, \@expect, '... even through a reference taken earlier' );
+    }
+}
+
+# the wrapped method is only compiled once it is called
+{
+    package Lazy;
+    our @ISA = ('Class::MOP::Object');
+
+    sub method {'orig'}
+
+    my $meta = Class::MOP::Class->initialize(__PACKAGE__);
+    $meta->add_before_method_modifier( method => sub { } ) for 1 .. 3;
+    $meta->add_around_method_modifier(
+        method => sub { my $orig = shift; uc $orig->(@_) } );
+    $meta->add_after_method_modifier( method => sub { } );
+
+    my $table = $meta->get_method('method')->{modifier_table};
+    ::ok( !$table->{cache}, 'adding modifiers does not compile the wrapped method' );
+    ::is( Lazy->method, 'ORIG', '... which works when called' );
+
+    my $compiled = $table->{cache};
+    ::ok( $compiled, '... and is compiled then' );
+    Lazy->method;
+    ::is( $table->{cache}, $compiled, '... only once' );
+    ::is( Lazy->can('method'), $compiled,
+        '... and installed in the place of the method' );
+    ::is( $meta->get_method('method')->body, $compiled,
+        '... and as the body of the method object' );
+    ::isa_ok( $meta->get_method('method'), 'Class::MOP::Method::Wrapped' );
+
+    $meta->add_before_method_modifier( method => sub { } );
+    ::ok( !$table->{cache}, 'adding another modifier throws it away' );
+    ::isnt( Lazy->can('method'), $compiled, '... and uninstalls it' );
+    ::ok(
+        $meta->get_method('method')->_finish_lazy_body,
+        '... and it can be compiled before it is called'
+    );
+    ::is( Lazy->method, 'ORIG', '... which works' );
+}
+
 done_testing;
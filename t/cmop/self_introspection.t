@@ -105,6 +105,9 @@ my @class_mop_class_methods = qw(
     remove_attribute
     find_attribute_by_name
     get_all_attributes
+    _all_attribute_map
+    _cached_over_classes
+    _warm_caches
 
     is_mutable is_immutable make_mutable make_immutable
     _initialize_immutable _install_inlined_code _inlined_methods
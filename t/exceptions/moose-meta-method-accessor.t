@@ -24,6 +24,10 @@ use Moose();
                          attribute     => $attr,
                          accessor_type => "writer"
                        );
+
+        # with MOOSE_LAZY_ACCESSORS set, the code is only generated when the
+        # method is first called
+        $foo->body->() if $ENV{MOOSE_LAZY_ACCESSORS};
     };
 
     like(
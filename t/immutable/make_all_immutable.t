@@ -0,0 +1,144 @@
+use strict;
+use warnings;
+
+use Test::More;
+use Test::Fatal;
+
+use B ();
+use Class::MOP;
+
+{
+    package Point;
+    use Moose;
+
+    has x => ( is => 'rw', isa => 'Int', default => 0 );
+    has y => ( is => 'rw', isa => 'Int', default => 0 );
+
+    sub DEMOLISH { $main::demolished++ }
+
+    package Point3D;
+    use Moose;
+    extends 'Point';
+
+    has z => ( is => 'rw', isa => 'Int', required => 1 );
+}
+
+my $plain = Class::MOP::Class->create(
+    'Plain',
+    attributes => [
+        Class::MOP::Attribute->new( name => ( accessor => 'name', predicate => 'has_name' ) ),
+    ],
+);
+
+my @metas = Class::MOP::make_all_immutable( 'Point', Point3D->meta, $plain );
+
+is_deeply(
+    [ map { $_->name } @metas ],
+    [qw( Point Point3D Plain )],
+    'returns the metaclasses'
+);
+ok( $_->is_immutable, $_->name . ' is immutable' ) for @metas;
+
+ok( B::svref_2object( Point->can('new') )->XSUB, 'Moose classes get an XS constructor' );
+is_deeply(
+    [ Class::MOP::get_code_info( Point->can('DESTROY') ) ],
+    [qw( Point DESTROY )],
+    'the destructor is named'
+);
+
+{
+    my $point = Point3D->new( x => 1, z => 3 );
+    is( $point->x + $point->y + $point->z, 4, 'the constructor works' );
+    like(
+        exception { Point3D->new( x => 1 ) },
+        qr/Attribute \(z\) is required/,
+        '... and checks required attributes'
+    );
+
+    local $main::demolished = 0;
+    undef $point;
+    is( $main::demolished, 1, 'the destructor works' );
+}
+
+{
+    my $obj = Plain->new( name => 'foo' );
+    is( $obj->name, 'foo', 'inlined accessor of a Class::MOP class' );
+    ok( $obj->has_name, 'inlined predicate' );
+    is_deeply(
+        [ Class::MOP::get_code_info( Plain->can('name') ) ],
+        [qw( Plain name )],
+        '... which are named'
+    );
+    is(
+        Plain->meta->get_method('name')->body,
+        Plain->can('name'),
+        'the method body is the installed code'
+    );
+}
+
+is(
+    { Point->meta->immutable_options }->{file},
+    __FILE__,
+    'the caller is recorded as where the class was made immutable'
+);
+
+{
+    package NoConstructor;
+    use Moose;
+    has foo => ( is => 'ro' );
+}
+
+Class::MOP::make_all_immutable( { inline_constructor => 0 }, 'NoConstructor' );
+ok( !NoConstructor->meta->has_method('new'), 'options are passed to make_immutable' );
+
+BEGIN {
+    package My::Meta::Class;
+    use Moose;
+    extends 'Moose::Meta::Class';
+
+    # calls a method compiled earlier in the same batch
+    before make_immutable => sub { $main::early = Early->new->foo };
+}
+
+{
+    package Early;
+    use Moose;
+    has foo => ( is => 'ro', default => 42 );
+
+    package Late;
+    use Moose -metaclass => 'My::Meta::Class';
+    has bar => ( is => 'ro' );
+}
+
+Class::MOP::make_all_immutable(qw( Early Late ));
+is( $main::early, 42, 'a method can be called before the batch is compiled' );
+is( Late->new( bar => 1 )->bar, 1, '... and the rest are compiled too' );
+
+{
+    package Broken::Constructor;
+    use parent -norequire, 'Class::MOP::Method::Constructor';
+
+    sub _generate_constructor_method_inline {
+        $_[0]->_compile_code( [ 'sub {', 'my $x = ;', '}' ] );
+    }
+
+    package Broken::Meta;
+    use parent -norequire, 'Class::MOP::Class';
+
+    sub constructor_class {'Broken::Constructor'}
+
+    package Fine;
+    use Moose;
+    has foo => ( is => 'ro', default => 1 );
+}
+
+like(
+    exception {
+        Class::MOP::make_all_immutable( Broken::Meta->create('Broken'), 'Fine' );
+    },
+    qr/Failed to compile source/,
+    'compilation errors are thrown at the end of the batch'
+);
+is( Fine->new->foo, 1, '... and the other classes are compiled' );
+
+done_testing;
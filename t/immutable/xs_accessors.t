@@ -0,0 +1,198 @@
+use strict;
+use warnings;
+
+use Test::More;
+use Test::Fatal;
+
+use B ();
+
+sub is_xs {
+    my ( $class, $name ) = @_;
+    return !!B::svref_2object( $class->can($name) )->XSUB;
+}
+
+{
+    package Foo;
+    use Moose;
+
+    has plain => ( is => 'ro' );
+    has typed => ( is => 'ro', isa => 'Int' );
+    has lazy  => ( is => 'ro', lazy => 1, default => 42 );
+    has deref => ( is => 'ro', isa => 'ArrayRef', auto_deref => 1 );
+    has named => ( reader => 'get_named' );
+    has wrapped => ( is => 'ro' );
+
+    around wrapped => sub {
+        my $orig = shift;
+        return uc $_[0]->$orig;
+    };
+
+    __PACKAGE__->meta->make_immutable;
+}
+
+{
+    package Bar;
+    use Moose;
+
+    has plain => ( is => 'ro' );
+
+    __PACKAGE__->meta->make_immutable( xs_accessors => 0 );
+}
+
+ok( is_xs( Foo => 'plain' ), 'plain reader is xs' );
+ok( is_xs( Foo => 'typed' ), 'reader with a type constraint is xs' );
+ok( is_xs( Foo => 'get_named' ), 'explicitly named reader is xs' );
+ok( !is_xs( Foo => 'lazy' ), 'lazy reader is not xs' );
+ok( !is_xs( Foo => 'deref' ), 'auto_deref reader is not xs' );
+ok( !is_xs( Foo => 'wrapped' ), 'reader with a modifier is not xs' );
+ok( !is_xs( Bar => 'plain' ), 'xs_accessors => 0 is respected' );
+
+{
+    my $foo = Foo->new(
+        plain   => 'p',
+        typed   => 10,
+        named   => 'n',
+        deref   => [ 1, 2 ],
+        wrapped => 'w',
+    );
+
+    is( $foo->plain,     'p',  'plain reader' );
+    is( $foo->typed,     10,   'typed reader' );
+    is( $foo->get_named, 'n',  'named reader' );
+    is( $foo->lazy,      42,   'lazy reader' );
+    is( $foo->wrapped,   'W',  'wrapped reader' );
+    is_deeply( [ $foo->deref ], [ 1, 2 ], 'auto_deref reader' );
+
+    my @list = Foo->new->plain;
+    is_deeply( \@list, [undef], 'unset slot returns undef in list context' );
+
+    like(
+        exception { $foo->plain('x') },
+        qr/Cannot assign a value to a read-only accessor/,
+        'assigning through an xs reader throws the usual exception'
+    );
+
+    like(
+        exception { Foo->plain },
+        qr/Can't use string \("Foo"\) as a HASH ref/,
+        'calling an xs reader as a class method fails as before'
+    );
+
+    $_ = 'MUTATED' for $foo->plain;
+    is( $foo->plain, 'p', 'aliasing the value returned by an xs reader does not change the slot' );
+}
+
+{
+    package Baz;
+    use Moose;
+    use Moose::Util::TypeConstraints;
+
+    subtype 'PositiveInt', as 'Int', where { $_ > 0 };
+
+    has int      => ( is => 'rw', isa => 'Int' );
+    has str      => ( is => 'rw', isa => 'Str' );
+    has maybe    => ( is => 'rw', isa => 'Maybe[Num]' );
+    has array    => ( is => 'rw', isa => 'ArrayRef' );
+    has untyped  => ( is => 'rw' );
+    has w_int    => ( reader => 'get_w_int', writer => 'set_w_int', isa => 'Int' );
+    has positive => ( is => 'rw', isa => 'PositiveInt' );
+    has params   => ( is => 'rw', isa => 'ArrayRef[Int]' );
+    has class    => ( is => 'rw', isa => 'Foo' );
+    has trigger  => ( is => 'rw', isa => 'Int', trigger => sub { } );
+    has weak     => ( is => 'rw', weak_ref => 1 );
+    has lazy     => ( is => 'rw', isa => 'Int', lazy => 1, default => 1 );
+    has required => ( is => 'rw', isa => 'Int', required => 1 );
+
+    __PACKAGE__->meta->make_immutable;
+}
+
+ok( is_xs( Baz => $_ ), "$_ accessor is xs" )
+    for qw( int str maybe array untyped set_w_int get_w_int required );
+ok( !is_xs( Baz => $_ ), "$_ accessor is not xs" )
+    for qw( positive params class trigger weak lazy );
+
+{
+    my $baz = Baz->new( required => 1 );
+
+    is( $baz->int(42), 42, 'accessor returns the new value' );
+    is( $baz->int, 42, 'accessor reads the value back' );
+    is( $baz->int('-7'), -7, 'Int accepts a numeric string' );
+    is( $baz->set_w_int(3), 3, 'writer returns the new value' );
+    is( $baz->get_w_int, 3, 'writer stored the value' );
+    is( $baz->str('foo'), 'foo', 'Str accessor' );
+    is( $baz->maybe(undef), undef, 'Maybe[Num] accepts undef' );
+    is( $baz->maybe('1.5e3'), '1.5e3', 'Maybe[Num] accepts a number' );
+    is_deeply( $baz->array( [1] ), [1], 'ArrayRef accessor' );
+    is( $baz->untyped( 'x' ), $baz->untyped, 'untyped accessor' );
+
+    s/new/ALIAS/ for $baz->str('new');
+    is( $baz->str, 'new', 'aliasing the value returned by an xs writer does not change the slot' );
+
+    for my $bad ( 1.5, '1 ', 'abc', undef, [] ) {
+        like(
+            exception { $baz->int($bad) },
+            qr/Attribute \(int\) does not pass the type constraint because: Validation failed for 'Int'/,
+            'invalid value for an xs accessor throws the usual exception'
+        );
+        is( $baz->int, -7, '... and leaves the slot alone' );
+    }
+
+    like(
+        exception { $baz->array( {} ) },
+        qr/Validation failed for 'ArrayRef'/,
+        'ArrayRef accessor checks its value'
+    );
+    like(
+        exception { $baz->set_w_int('x') },
+        qr/Validation failed for 'Int'/,
+        'writer checks its value'
+    );
+    like(
+        exception { $baz->set_w_int },
+        qr/Attribute \(w_int\) does not pass the type constraint/,
+        'writer without a value behaves like the perl one'
+    );
+}
+
+{
+    my $method = Foo->meta->get_method('plain');
+    isa_ok( $method, 'Moose::Meta::Method::Accessor' );
+    is( $method->associated_attribute->name, 'plain',
+        'xs reader knows its attribute' );
+    is( $method->accessor_type, 'reader', 'xs reader has the right type' );
+}
+
+{
+    package Unicode;
+    use Moose;
+    use utf8;
+
+    has 'ñame' => ( is => 'rw', isa => 'Str' );
+    has plain  => ( is => 'rw', default => 'unicode' );
+
+    __PACKAGE__->meta->make_immutable;
+}
+
+{
+    use utf8;
+
+    my $obj = Unicode->new( 'ñame' => 'x' );
+    ok( is_xs( Unicode => 'ñame' ), 'xs accessor for a utf8 attribute name' );
+    is( $obj->ñame, 'x', '... reads the slot' );
+    $obj->ñame('y');
+    is( $obj->{'ñame'}, 'y', '... and writes it' );
+
+    is( $obj->plain, 'unicode', 'slot names shared between classes' );
+    is( Foo->new( plain => 'foo' )->plain, 'foo', '... are kept apart' );
+}
+
+{
+    Foo->meta->make_mutable;
+    ok( !is_xs( Foo => 'plain' ), 'make_mutable restores the perl reader' );
+    is( Foo->new( plain => 'p' )->plain, 'p', 'restored reader works' );
+
+    Foo->meta->make_immutable;
+    ok( is_xs( Foo => 'plain' ), 'xs reader is back after make_immutable' );
+}
+
+done_testing;
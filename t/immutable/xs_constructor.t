@@ -0,0 +1,245 @@
+use strict;
+use warnings;
+
+use Test::More;
+use Test::Fatal;
+
+use B ();
+
+sub is_xs {
+    my ( $class, $name ) = @_;
+    return !!B::svref_2object( $class->can($name) )->XSUB;
+}
+
+my @triggered;
+my @built;
+
+{
+    package Foo;
+    use Moose;
+    use Moose::Util::TypeConstraints;
+
+    subtype 'Upper', as 'Str', where { !/[a-z]/ };
+    coerce 'Upper', from 'Str', via { uc };
+
+    has int      => ( is => 'ro', isa => 'Int', required => 1 );
+    has str      => ( is => 'ro', isa => 'Str', default => 'str' );
+    has list     => ( is => 'ro', isa => 'ArrayRef', default => sub { [] } );
+    has built    => ( is => 'ro', isa => 'Int', builder => '_build_built' );
+    has untyped  => ( is => 'ro', builder => '_build_untyped' );
+    has code     => ( is => 'ro', default => sub { ref $_[0] } );
+    has lazy     => ( is => 'ro', lazy => 1, default => 'lazy' );
+    has upper    => ( is => 'ro', isa => 'Upper', coerce => 1 );
+    has custom   => ( is => 'ro', isa => 'Upper' );
+    has weak     => ( is => 'ro', weak_ref => 1 );
+    has no_init  => ( is => 'ro', init_arg => undef, default => 'none' );
+    has renamed  => ( is => 'ro', init_arg => 'other' );
+    has maybe    => ( is => 'ro', isa => 'Maybe[Int]' );
+    has init     => (
+        is          => 'ro',
+        initializer => sub { $_[2]->( $_[1] * 2 ) },
+    );
+    has trigger => (
+        is      => 'ro',
+        isa     => 'Int',
+        trigger => sub { push @triggered, [ 'trigger', $_[1] ] },
+    );
+
+    sub _build_built   {42}
+    sub _build_untyped { [ 'untyped', ref $_[0] ] }
+
+    sub BUILD { push @built, [ 'Foo', $_[1] ] }
+
+    __PACKAGE__->meta->make_immutable;
+}
+
+{
+    package Bar;
+    use Moose;
+    extends 'Foo';
+
+    sub BUILD { push @built, [ 'Bar', $_[1] ] }
+
+    __PACKAGE__->meta->make_immutable;
+}
+
+{
+    package Baz;
+    use Moose;
+    extends 'Foo';
+
+    sub BUILDARGS {
+        my $class = shift;
+        return { int => shift };
+    }
+
+    __PACKAGE__->meta->make_immutable;
+}
+
+{
+    package Mutable;
+    use Moose;
+    extends 'Foo';
+}
+
+{
+    package NoXS;
+    use Moose;
+
+    has foo => ( is => 'ro' );
+
+    __PACKAGE__->meta->make_immutable( xs_constructor => 0 );
+}
+
+ok( is_xs( $_ => 'new' ), "$_ has an xs constructor" ) for qw( Foo Bar Baz );
+ok( !is_xs( NoXS => 'new' ), 'xs_constructor => 0 is respected' );
+
+{
+    @triggered = @built = ();
+    my $ref = [];
+    my $foo = Foo->new(
+        int     => 1,
+        upper   => 'abc',
+        custom  => 'ABC',
+        weak    => $ref,
+        other   => 'other',
+        no_init => 'ignored',
+        init    => 21,
+        trigger => 5,
+        maybe   => undef,
+    );
+
+    isa_ok( $foo, 'Foo' );
+    is( $foo->int,   1,     'required attribute' );
+    is( $foo->str,   'str', 'plain default' );
+    is_deeply( $foo->list, [], 'default sub' );
+    is( $foo->built, 42, 'builder' );
+    is_deeply( $foo->untyped, [ 'untyped', 'Foo' ], 'builder gets the instance' );
+    is( $foo->code, 'Foo', 'default sub gets the instance' );
+    ok( !exists $foo->{lazy}, 'lazy attribute is not initialized' );
+    is( $foo->lazy, 'lazy', '... until it is read' );
+    is( $foo->upper,   'ABC',   'coercion' );
+    is( $foo->custom,  'ABC',   'custom type' );
+    is( $foo->weak,    $ref,    'weak_ref' );
+    is( $foo->no_init, 'none',  'init_arg => undef' );
+    is( $foo->renamed, 'other', 'init_arg' );
+    is( $foo->maybe,   undef,   'Maybe' );
+    is( $foo->init,    42,      'initializer' );
+    is( $foo->trigger, 5,       'triggered attribute' );
+
+    is_deeply( \@triggered, [ [ 'trigger', 5 ] ], 'trigger was called' );
+    is( scalar @built, 1, 'BUILD was called once' );
+    is( $built[0][1]{other}, 'other', 'BUILD gets the params' );
+
+    @built = ();
+    undef $ref;
+    is( $foo->weak, undef, 'weak_ref is weak' );
+
+    my $copy = { int => 1 };
+    Foo->new($copy)->{int} = 2;
+    is( $copy->{int}, 1, 'params hash ref is copied' );
+}
+
+{
+    @triggered = @built = ();
+    my $bar = Bar->new( int => 1, trigger => 1 );
+    isa_ok( $bar, 'Bar' );
+    is_deeply( [ map { $_->[0] } @built ], [qw( Foo Bar )], 'BUILD order' );
+
+    @built = ();
+    Bar->new( int => 1, __no_BUILD__ => 1 );
+    is_deeply( \@built, [], '__no_BUILD__' );
+
+    is( Baz->new(7)->int, 7, 'custom BUILDARGS' );
+
+    my $mutable = Mutable->new( int => 3 );
+    isa_ok( $mutable, 'Mutable', 'subclass using the parent constructor' );
+    is( $mutable->int, 3, '... which initializes it' );
+}
+
+{
+    like(
+        exception { Foo->new },
+        qr/\QAttribute (int) is required/,
+        'missing required attribute'
+    );
+    like(
+        exception { Foo->new( int => 'x' ) },
+        qr/\QAttribute (int) does not pass the type constraint because: Validation failed for 'Int' with value x/,
+        'invalid value'
+    );
+    like(
+        exception { Foo->new( int => 1, custom => 'abc' ) },
+        qr/\QAttribute (custom) does not pass the type constraint/,
+        'invalid value for a custom type'
+    );
+    like(
+        exception { Foo->new( [] ) },
+        qr/\QSingle parameters to new() must be a HASH ref/,
+        'invalid params'
+    );
+
+    my @warnings;
+    local $SIG{__WARN__} = sub { push @warnings, @_ };
+    Foo->new( int => 1, 'other' );
+    like(
+        $warnings[0],
+        qr/\QThe new() method for Foo expects a hash reference or a key\/value list. You passed an odd number of arguments at $0 line/,
+        'odd number of arguments'
+    );
+}
+
+{
+    my $foo = Foo->new( int => 1 );
+    is( ref( $foo->new( int => 2 ) ), 'Foo', 'new called on an instance' );
+}
+
+# the trace of an exception starts where it was made, whether or not the
+# constructor has a frame of its own
+{
+    package My::Exception;
+    use Moose;
+    extends 'Moose::Exception';
+
+    has cause => ( is => 'rw' );
+
+    sub BUILD {
+        my $self = shift;
+        $self->cause( My::Exception::Cause->new ) unless $self->isa('My::Exception::Cause');
+    }
+
+    __PACKAGE__->meta->make_immutable( xs_constructor => 0 );
+
+    package My::Exception::Cause;
+    use Moose;
+    extends 'My::Exception';
+
+    __PACKAGE__->meta->make_immutable;
+}
+
+{
+    ok( is_xs( 'My::Exception::Cause', 'new' ), 'exception with a C constructor' );
+    ok( !is_xs( 'My::Exception', 'new' ), '... made by one with a perl constructor' );
+
+    my $make = sub { $_[0]->new };
+
+    is(
+        ( $make->('My::Exception::Cause')->trace->frames )[0]->subroutine,
+        'main::__ANON__',
+        'trace starts where the exception was made'
+    );
+
+    my $e = $make->('My::Exception');
+    is(
+        ( $e->trace->frames )[0]->subroutine,
+        'main::__ANON__',
+        '... with a perl constructor too'
+    );
+    is(
+        ( $e->cause->trace->frames )[0]->subroutine,
+        'My::Exception::BUILD',
+        '... and for an exception made while building it'
+    );
+}
+
+done_testing;
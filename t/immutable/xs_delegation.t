@@ -0,0 +1,135 @@
+use strict;
+use warnings;
+
+use Test::More;
+use Test::Fatal;
+
+use B ();
+
+sub is_xs {
+    my ( $class, $name ) = @_;
+    return !!B::svref_2object( $class->can($name) )->XSUB;
+}
+
+{
+    package Client;
+
+    my $count = 0;
+    sub new { bless { id => ++$count }, shift }
+    sub id   { $_[0]{id} }
+    sub echo { shift; return @_ }
+    sub context { wantarray ? 'list' : defined wantarray ? 'scalar' : 'void' }
+    sub class_method { ref $_[0] || $_[0] }
+    sub clear_holder { $_[1]->clear_client; $_[0]{id} }
+    sub rename_self { $_[0] = 'renamed' }
+}
+
+{
+    package Holder;
+    use Moose;
+
+    has client => (
+        is        => 'rw',
+        clearer   => 'clear_client',
+        predicate => 'has_client',
+        handles   => {
+            id           => 'id',
+            echo         => 'echo',
+            curried      => [ echo => qw( a b ) ],
+            context      => 'context',
+            class_method => 'class_method',
+            clear_holder => 'clear_holder',
+            rename_self  => 'rename_self',
+        },
+    );
+
+    has lazy_client => (
+        is      => 'ro',
+        lazy    => 1,
+        default => sub { Client->new },
+        handles => { lazy_id => 'id' },
+    );
+
+    has wrapped => ( is => 'ro', handles => { wrapped_id => 'id' } );
+
+    around wrapped => sub { Client->new };
+
+    has code => ( is => 'ro', handles => { code_id => sub { 'code' } } );
+
+    __PACKAGE__->meta->make_immutable;
+}
+
+{
+    package Child;
+    use Moose;
+    extends 'Holder';
+
+    package OwnReader;
+    use Moose;
+    extends 'Holder';
+
+    sub client { Client->new }
+}
+
+ok( is_xs( Holder => 'id' ),       'delegation is xs' );
+ok( is_xs( Holder => 'curried' ),  'delegation with curried arguments is xs' );
+ok( is_xs( Holder => 'lazy_id' ),  'delegation through a lazy reader is xs' );
+ok( !is_xs( Holder => 'wrapped_id' ), 'delegation through a wrapped reader is not xs' );
+
+my $client = Client->new;
+my $holder = Holder->new( client => $client );
+
+is( $holder->id, $client->id, 'delegates to the object in the slot' );
+is_deeply( [ $holder->echo( 1, 2 ) ], [ 1, 2 ], 'arguments are passed on' );
+is_deeply(
+    [ $holder->curried( 1 .. 10 ) ], [ qw( a b ), 1 .. 10 ],
+    'curried arguments are passed before them'
+);
+is( scalar $holder->echo( 1, 2 ), 2, 'scalar context is passed on' );
+is( $holder->context, 'scalar', '... as seen by the method' );
+is_deeply( [ $holder->context ], ['list'], '... and list context' );
+
+{
+    my $id = $holder->clear_holder($holder);
+    is( $id, $client->id, 'the method can clear the slot it was called through' );
+    ok( !$holder->has_client, '... which is cleared' );
+}
+
+like(
+    exception { $holder->id },
+    qr/Cannot delegate id to id because the value of client is not defined/,
+    'undefined value gives the usual error'
+);
+
+$holder->client( {} );
+like(
+    exception { $holder->id },
+    qr/Cannot delegate id to id because the value of client is not an object/,
+    'unblessed value gives the usual error'
+);
+
+$holder->client('Client');
+is( $holder->class_method, 'Client', 'a class name in the slot is the invocant' );
+
+$holder->client($client);
+$holder->rename_self;
+is( $holder->client, $client, 'the method gets a copy of the value' );
+
+{
+    my $lazy = Holder->new;
+    is( $lazy->lazy_id, $lazy->lazy_client->id, 'lazy default is built on first call' );
+}
+
+is( $holder->code_id, 'code', 'code ref delegation still works' );
+
+is( Child->new( client => $client )->id, $client->id, 'subclasses delegate' );
+isnt(
+    OwnReader->new( client => $client )->id, $client->id,
+    'subclasses overriding the reader get their reader'
+);
+
+Holder->meta->make_mutable;
+ok( !is_xs( Holder => 'id' ), 'make_mutable restores the perl delegation' );
+is( Holder->new( client => $client )->id, $client->id, '... which works' );
+
+done_testing;
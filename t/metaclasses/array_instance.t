@@ -0,0 +1,97 @@
+use strict;
+use warnings;
+
+use Test::More;
+use Test::Fatal;
+use Test::Moose qw( with_immutable );
+
+use Scalar::Util 'reftype';
+
+my @demolished;
+
+{
+    package Point;
+    use metaclass 'Moose::Meta::Class' => (
+        instance_metaclass => 'Moose::Meta::Instance::Array',
+    );
+    use Moose;
+
+    has x => ( is => 'rw', isa => 'Int', required => 1 );
+    has y => (
+        is        => 'rw',
+        isa       => 'Int',
+        lazy      => 1,
+        default   => 0,
+        predicate => 'has_y',
+        clearer   => 'clear_y',
+    );
+    has tags => (
+        traits  => ['Array'],
+        is      => 'ro',
+        default => sub { [] },
+        handles => { add_tag => 'push', tag_count => 'count' },
+    );
+    has owner => ( is => 'rw', weak_ref => 1 );
+
+    sub DEMOLISH { push @demolished, ref $_[0] }
+}
+
+{
+    package Point3D;
+    use Moose;
+    extends 'Point';
+
+    has z => ( is => 'rw', trigger => sub { $_[0]->add_tag('z') } );
+}
+
+isa_ok(
+    Point3D->meta->get_meta_instance, 'Moose::Meta::Instance::Array',
+    'a subclass inherits the instance metaclass'
+);
+isa_ok( Point->meta->get_meta_instance, 'Moose::Meta::Instance' );
+
+with_immutable {
+    my $p = Point3D->new( x => 1, z => 2 );
+
+    is( reftype($p), 'ARRAY', 'instances are arrays' );
+    is( $p->x, 1, 'attribute from the parent' );
+    is( $p->z, 2, 'attribute from the subclass' );
+    is_deeply( $p->tags, ['z'], 'trigger and native trait' );
+
+    ok( !$p->has_y, 'lazy attribute is not set' );
+    is( $p->y, 0, '... until it is read' );
+    ok( $p->has_y, '... then it is' );
+    $p->clear_y;
+    ok( !$p->has_y, 'clearer' );
+
+    $p->add_tag('a');
+    is( $p->tag_count, 2, 'native delegation' );
+
+    {
+        my $owner = Point->new( x => 0 );
+        $p->owner($owner);
+        is( $p->owner, $owner, 'weak_ref' );
+    }
+    is( $p->owner, undef, '... is weak' );
+
+    like(
+        exception { $p->x('foo') },
+        qr/\QAttribute (x) does not pass the type constraint/,
+        'type constraint'
+    );
+    like(
+        exception { Point->new },
+        qr/\QAttribute (x) is required/,
+        'required attribute'
+    );
+
+    @demolished = ();
+    undef $p;
+    is_deeply( \@demolished, ['Point3D'], 'DEMOLISH' );
+
+    my $anon = Moose::Meta::Class->create_anon_class( superclasses => ['Point'] );
+    is( $anon->new_object( x => 3 )->x, 3, 'anon subclass' );
+}
+qw( Point Point3D );
+
+done_testing;
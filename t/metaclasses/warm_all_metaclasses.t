@@ -0,0 +1,59 @@
+use strict;
+use warnings;
+
+use Test::More;
+
+BEGIN { $ENV{MOOSE_LAZY_ACCESSORS} = 1 }
+
+{
+    package Role;
+    use Moose::Role;
+
+    package Parent;
+    use Moose;
+    with 'Role';
+
+    has x => ( is => 'rw', predicate => 'has_x' );
+
+    sub plain {'plain'}
+
+    package Child;
+    use Moose;
+    extends 'Parent';
+
+    has y => ( is => 'ro', clearer => 'clear_y' );
+}
+
+my %before = map { $_ => Child->can($_) } qw( x has_x y clear_y );
+
+my $report = Class::MOP::warm_all_metaclasses();
+
+cmp_ok( $report->{metaclasses}, '>=', 3, 'went through the metaclasses' );
+cmp_ok( $report->{methods}, '>', 0, 'made method objects' );
+cmp_ok( $report->{compiled_methods}, '>=', 4, 'compiled the lazy accessors' );
+
+for my $name ( sort keys %before ) {
+    isnt( Child->can($name), $before{$name}, "$name is compiled" );
+}
+
+ok( Parent->meta->_method_map->{plain}, 'method objects are made for plain subs' );
+
+my $meta    = Child->meta;
+my %entries = %{ $meta->{_cached_over_classes} };
+ok( $entries{all_methods}, 'the methods of the class are cached' );
+ok( $entries{all_attributes}, '... as are its attributes' );
+
+$meta->get_all_methods;
+$meta->get_all_attributes;
+is( $meta->{_cached_over_classes}{$_}, $entries{$_}, "$_ is still cached after warming" )
+    for qw( all_methods all_attributes );
+
+ok( Child->new->does('Role'), 'roles are still found' );
+
+is_deeply(
+    Class::MOP::warm_all_metaclasses(),
+    { %{$report}, methods => 0, compiled_methods => 0 },
+    'warming again has nothing to do'
+);
+
+done_testing;
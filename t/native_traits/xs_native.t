@@ -0,0 +1,190 @@
+use strict;
+use warnings;
+
+use Test::More;
+use Test::Fatal;
+
+use B ();
+
+sub is_xs {
+    my ( $class, $name ) = @_;
+    return !!B::svref_2object( $class->can($name) )->XSUB;
+}
+
+{
+    package TiedArray;
+    require Tie::Array;
+    our @ISA = ('Tie::StdArray');
+}
+
+{
+    package Foo;
+    use Moose;
+    use Moose::Util::TypeConstraints;
+
+    subtype 'SmallInt', as 'Int', where { $_ < 100 };
+
+    has list => (
+        traits  => ['Array'],
+        is      => 'rw',
+        isa     => 'ArrayRef',
+        default => sub { [ 1 .. 5 ] },
+        handles => {
+            count    => 'count',
+            get      => 'get',
+            second   => [ get => 1 ],
+            elements => 'elements',
+            is_empty => 'is_empty',
+        },
+    );
+
+    has map => (
+        traits  => ['Hash'],
+        is      => 'rw',
+        isa     => 'HashRef',
+        lazy    => 1,
+        default => sub { { a => 1, b => 2 } },
+        handles => {
+            hash_count => 'count',
+            hash_get   => 'get',
+            exists     => 'exists',
+            keys       => 'keys',
+        },
+    );
+
+    has counter => (
+        traits  => ['Counter'],
+        is      => 'rw',
+        isa     => 'Int',
+        default => 0,
+        handles => { inc => 'inc', dec => 'dec', inc_10 => [ inc => 10 ] },
+    );
+
+    has small => (
+        traits  => ['Counter'],
+        is      => 'ro',
+        isa     => 'SmallInt',
+        default => 0,
+        handles => { inc_small => 'inc' },
+    );
+
+    has triggered => (
+        traits  => ['Bool'],
+        is      => 'ro',
+        isa     => 'Bool',
+        default => 0,
+        trigger => sub { },
+        handles => { toggle_triggered => 'toggle' },
+    );
+
+    has flag => (
+        traits  => ['Bool'],
+        is      => 'ro',
+        isa     => 'Bool',
+        default => 0,
+        handles => { toggle => 'toggle' },
+    );
+
+    has string => (
+        traits  => ['String'],
+        is      => 'rw',
+        isa     => 'Str',
+        default => q{},
+        handles => { length => 'length', append => 'append' },
+    );
+
+    __PACKAGE__->meta->make_immutable;
+}
+
+for my $name (
+    qw( count get second elements is_empty hash_count hash_get exists keys
+        inc dec inc_10 toggle length )
+    ) {
+    ok( is_xs( Foo => $name ), "$name is xs" );
+}
+ok( !is_xs( Foo => 'inc_small' ), 'writer whose type must be checked is not xs' );
+ok( !is_xs( Foo => 'toggle_triggered' ), 'writer with a trigger is not xs' );
+ok( !is_xs( Foo => 'append' ), 'other operations are not xs' );
+
+my $foo = Foo->new;
+
+{
+    is( $foo->count, 5, 'count' );
+    is( scalar $foo->elements, 5, 'elements in scalar context' );
+    is_deeply( [ $foo->elements ], [ 1 .. 5 ], 'elements in list context' );
+    is( $foo->get(0), 1, 'get' );
+    is( $foo->get(-1), 5, 'get with a negative index' );
+    is( $foo->get("2\n"), 3, 'get with an index string' );
+    is( $foo->get(10), undef, 'get past the end' );
+    is( $foo->second, 2, 'get with a curried index' );
+    is( $foo->is_empty, 0, 'is_empty' );
+
+    $_++ for $foo->elements;
+    is_deeply( $foo->list, [ 1 .. 5 ], 'elements returns copies' );
+
+    like(
+        exception { $foo->get('x') },
+        qr/The index passed to get must be an integer/,
+        'bad index gives the usual error'
+    );
+    like(
+        exception { $foo->count(1) },
+        qr/Cannot call count with any arguments/,
+        'extra arguments give the usual error'
+    );
+
+    tie my @tied, 'TiedArray';
+    @tied = ( 1, 2 );
+    $foo->list( \@tied );
+    is( $foo->count, 2, 'tied arrays are counted' );
+    is( $foo->get(1), 2, '... and read' );
+}
+
+{
+    my $lazy = Foo->new;
+    is( $lazy->hash_count, 2, 'lazy default is built on first call' );
+    is( $lazy->hash_get('b'), 2, 'hash get' );
+    is_deeply( [ $lazy->hash_get(qw( a b c )) ], [ 1, 2, undef ], 'hash get of several keys' );
+    is( scalar $lazy->hash_get(qw( a b )), 2, '... in scalar context' );
+    ok( $lazy->exists('a'), 'exists' );
+    ok( !$lazy->exists('c'), '... and not' );
+    is_deeply( [ sort $lazy->keys ], [qw( a b )], 'keys' );
+    is( scalar $lazy->keys, 2, '... in scalar context' );
+    like(
+        exception { $lazy->hash_get(undef) },
+        qr/The key passed to get must be a defined value/,
+        'undefined key gives the usual error'
+    );
+}
+
+{
+    is( $foo->inc, 1, 'inc' );
+    is( $foo->inc(5), 6, 'inc by an amount' );
+    is( $foo->dec, 5, 'dec' );
+    is( $foo->inc_10, 15, 'inc by a curried amount' );
+    is( $foo->counter, 15, '... stored' );
+
+    is( $foo->inc('2'), 17, 'inc by a string' );
+    is( $foo->dec(undef), 16, 'dec by undef is dec by one' );
+
+    $foo->counter( ~0 >> 1 );
+    is( $foo->inc, ( ~0 >> 1 ) + 1, 'overflow is left to perl' );
+
+    is( $foo->inc_small, 1, 'checked writer works' );
+    like( exception { $foo->inc_small(200) }, qr/SmallInt/, '... and checks' );
+}
+
+{
+    is( $foo->toggle, 1, 'toggle' );
+    is( $foo->toggle, 0, '... back' );
+    is( $foo->flag, 0, '... stored' );
+}
+
+{
+    $foo->string("caf\x{e9}\x{263a}");
+    is( $foo->length, 5, 'length of a character string' );
+    $foo->string(12345);
+    is( $foo->length, 5, 'length of a number' );
+}
+
+done_testing;
@@ -0,0 +1,166 @@
+use strict;
+use warnings;
+
+use Test::More;
+use Test::Fatal;
+
+use B ();
+use Moose::Util qw( apply_all_roles );
+
+{
+    package Inner;
+    use Moose::Role;
+
+    package Outer;
+    use Moose::Role;
+    with 'Inner';
+
+    package Later;
+    use Moose::Role;
+
+    package Other;
+    use Moose::Role;
+
+    package Parent;
+    use Moose;
+    with 'Outer';
+
+    package Child;
+    use Moose;
+    extends 'Parent';
+
+    package Stranger;
+    use Moose;
+}
+
+ok( B::svref_2object( \&Moose::Object::does )->XSUB, 'does is implemented in C' );
+ok( B::svref_2object( \&Moose::Object::DOES )->XSUB, '... and so is DOES' );
+
+for my $try ( 1, 2 ) {
+    my $child = Child->new;
+    ok( $child->does('Outer'),  "role of a superclass (try $try)" );
+    ok( $child->does('Inner'),  "role composed into that role (try $try)" );
+    ok( !$child->does('Later'), "role it does not do (try $try)" );
+    ok( Child->does('Inner'),   "class name (try $try)" );
+    ok( $child->does( Inner->meta ), "role metaclass (try $try)" );
+    is( $child->does('Later'), 0, "false is 0 (try $try)" );
+    is( $child->does('Inner'), 1, "true is 1 (try $try)" );
+    ok( $child->DOES('Inner'),  "DOES (try $try)" );
+    ok( $child->DOES('Parent'), "DOES of a superclass (try $try)" );
+    ok( $child->DOES('Child'),  "DOES of its own class (try $try)" );
+    ok( !$child->DOES('Later'), "DOES of a role it does not do (try $try)" );
+    ok( Child->DOES('Outer'),   "DOES of a class name (try $try)" );
+    ok( Child->meta->does_role('Inner'), "does_role (try $try)" );
+}
+
+like(
+    exception { Child->new->does(undef) },
+    qr/You must supply a role name to does\(\)/,
+    'undefined role name is an error'
+);
+
+{
+    my $child = Child->new;
+    ok( !$child->does('Later'), 'role not done yet' );
+
+    Later->meta->apply( Parent->meta );
+    ok( $child->does('Later'), 'role added to a superclass is noticed' );
+
+    Other->meta->add_role( Moose::Meta::Role->initialize('Extra') );
+    apply_all_roles( 'Parent', 'Other' );
+    ok( $child->does('Extra'), 'role composed into a newly applied role is noticed' );
+}
+
+{
+    my $child = Child->new;
+    ok( $child->does('Outer'), 'role of the superclass' );
+
+    @Child::ISA = ('Stranger');
+    ok( !$child->does('Outer'), 'changing @ISA is noticed' );
+    ok( !Child->meta->does_role('Outer'), '... by does_role too' );
+
+    @Child::ISA = ('Parent');
+    ok( $child->does('Outer'), '... and changing it back' );
+}
+
+{
+    my $stranger = Stranger->new;
+    ok( !$stranger->does('Other'), 'object without the role' );
+
+    apply_all_roles( $stranger, 'Other' );
+    ok( $stranger->does('Other'), 'role applied to the object' );
+    ok( !Stranger->new->does('Other'), '... and not to others of its class' );
+}
+
+{
+    package Frozen;
+    use Moose;
+    with 'Outer';
+
+    __PACKAGE__->meta->make_immutable;
+}
+
+for my $try ( 1, 2 ) {
+    ok( Frozen->new->does('Inner'),  "immutable class (try $try)" );
+    ok( !Frozen->new->does('Later'), "... without the role (try $try)" );
+}
+
+Frozen->meta->make_mutable;
+Later->meta->apply( Frozen->meta );
+ok( Frozen->new->does('Later'), 'role added after making the class mutable' );
+
+BEGIN {
+    package My::Meta::Class;
+    use Moose;
+    extends 'Moose::Meta::Class';
+
+    around does_role => sub {
+        my $orig = shift;
+        my ( $self, $role ) = @_;
+        return 1 if $role eq 'Everything';
+        return $self->$orig($role);
+    };
+}
+
+{
+    package Custom;
+    use Moose -metaclass => 'My::Meta::Class';
+    with 'Inner';
+}
+
+for my $try ( 1, 2 ) {
+    ok( Custom->new->does('Everything'), "does_role of the metaclass is asked (try $try)" );
+    ok( Custom->new->does('Inner'),      "... as well as the roles (try $try)" );
+}
+
+{
+    package OwnDoes;
+    use Moose;
+    with 'Inner';
+
+    sub does { $_[1] eq 'Nothing' ? 1 : $_[0]->SUPER::does( $_[1] ) }
+}
+
+ok( OwnDoes->new->does('Nothing'), 'class with its own does is asked' );
+ok( OwnDoes->new->does('Inner'),   '... and can call the original' );
+ok( OwnDoes->new->DOES('Nothing'), '... by DOES too' );
+
+{
+    package NeverDoes;
+    use Moose;
+    with 'Inner';
+
+    sub does {0}
+}
+
+ok( NeverDoes->meta->does_role('Inner'), 'the metaclass knows its role' );
+ok( !NeverDoes->new->DOES('Inner'), '... but DOES asks does of the class' );
+
+{
+    package NotMoose;
+    sub new { bless {}, shift }
+}
+
+ok( !Moose::Object::does( NotMoose->new, 'Inner' ), 'object of a non-Moose class' );
+
+done_testing;
@@ -0,0 +1,149 @@
+use strict;
+use warnings;
+
+use Test::More;
+
+use B ();
+use Scalar::Util ();
+use Moose::Util::TypeConstraints;
+
+{
+    package Base;
+    sub new { bless {}, shift }
+
+    package Middle;
+    our @ISA = ('Base');
+
+    package Leaf;
+    our @ISA = ('Middle');
+
+    package Other;
+    sub new { bless {}, shift }
+
+    package Liar;
+    sub new { bless {}, shift }
+    sub isa { $_[1] eq 'Base' || $_[0]->SUPER::isa( $_[1] ) }
+}
+
+class_type 'Base';
+subtype 'NamedBase', as 'Base', where { 1 };
+
+my $type  = find_type_constraint('Base');
+my $check = $type->_compiled_type_constraint;
+my $named = find_type_constraint('NamedBase');
+
+ok( B::svref_2object($check)->XSUB, 'class types are checked in C' );
+is_deeply( $type->inline_environment, {}, '... but the inlined check needs no environment' );
+
+for my $try ( 1, 2 ) {
+    ok( $check->( Leaf->new ),    "object of a subclass passes (try $try)" );
+    ok( $check->( Base->new ),    "object of the class passes (try $try)" );
+    ok( !$check->( Other->new ),  "object of another class fails (try $try)" );
+    ok( $check->( Liar->new ),    "class with its own isa method is asked (try $try)" );
+    ok( $named->check( Leaf->new ), "subtype uses the same check (try $try)" );
+    ok( !$named->check( Other->new ), "... which fails other classes (try $try)" );
+}
+
+ok( !$check->(undef),               'undef fails' );
+ok( !$check->('Base'),              'class name fails' );
+ok( !$check->( {} ),                'unblessed ref fails' );
+ok( !$check->( bless {}, '0' ),     'object blessed into 0 fails' );
+
+{
+    my $leaf = Leaf->new;
+    ok( $check->($leaf), 'object passes' );
+
+    @Middle::ISA = ();
+    ok( !$check->($leaf),           'changing @ISA of an ancestor is noticed' );
+    ok( !$named->check($leaf),      '... by the subtype too' );
+
+    @Middle::ISA = ('Base');
+    ok( $check->($leaf),            '... and changing it back' );
+
+    bless $leaf, 'Other';
+    ok( !$check->($leaf),           'reblessed object is checked as its new class' );
+}
+
+{
+    my $leaf = Leaf->new;
+    ok( $check->($leaf), 'object passes' );
+
+    no warnings 'once';
+    local *Middle::isa = sub {0};
+    ok( !$check->($leaf),           'isa method added to an ancestor is called' );
+}
+ok( $check->( Leaf->new ), '... and not once it is removed' );
+
+{
+    my @classes = map {"Many::Class$_"} 1 .. 20;
+    {
+        no strict 'refs';
+        @{"${_}::ISA"} = ('Base') for @classes[ 0 .. 9 ];
+    }
+
+    my $ok = 1;
+    for ( 1 .. 3 ) {
+        for my $i ( 0 .. $#classes ) {
+            my $got = !!$check->( bless {}, $classes[$i] );
+            $ok = 0 unless $got eq !!( $i < 10 );
+        }
+    }
+    ok( $ok, 'more classes than fit in the cache are checked correctly' );
+}
+
+{
+    my $meta = Class::MOP::Class->create_anon_class( superclasses => ['Base'] );
+    ok( $check->( $meta->new_object ), 'object of an anonymous class passes' );
+
+    my $stash = do { no strict 'refs'; \%{ $meta->name . '::' } };
+    Scalar::Util::weaken($stash);
+    undef $meta;
+    ok( !defined $stash, '... and the check does not keep its stash alive' );
+}
+
+{
+    package Holder;
+    use Moose;
+
+    has base => ( is => 'rw', isa => 'Base' );
+}
+
+for my $immutable ( 0, 1 ) {
+    Holder->meta->make_immutable if $immutable;
+    my $desc = $immutable ? 'immutable' : 'mutable';
+
+    my $holder = Holder->new( base => Leaf->new );
+    ok( $holder->base->isa('Leaf'), "$desc constructor accepts a subclass" );
+    ok( !eval { $holder->base( Other->new ); 1 }, "$desc writer rejects another class" );
+    ok( eval { $holder->base( Liar->new ); 1 }, "$desc writer asks classes with their own isa" );
+}
+
+{
+    package Point;
+    use Moose;
+    has x => ( is => 'ro', default => 0 );
+}
+
+{
+    class_type 'Point';
+    subtype 'BigPoint',
+        as 'Point',
+        where { $_->x > 5 },
+        inline_as { $_[0]->parent->_inline_check( $_[1] ) . " && $_[1]->x > 5" };
+
+    package HasBigPoint;
+    use Moose;
+    has point => ( is => 'rw', isa => 'BigPoint' );
+    __PACKAGE__->meta->make_immutable;
+}
+
+{
+    my $holder = HasBigPoint->new( point => Point->new( x => 10 ) );
+    is( $holder->point->x, 10, 'a subtype can embed the inlined check of its class type parent' );
+    ok(
+        !eval { $holder->point( Point->new( x => 1 ) ); 1 },
+        '... which rejects bad values'
+    );
+}
+
+done_testing;
@@ -0,0 +1,127 @@
+use strict;
+use warnings;
+
+use Test::More;
+use Test::Fatal;
+
+use B ();
+use Moose::Util::TypeConstraints;
+
+{
+    package TiedScalar;
+    require Tie::Scalar;
+    our @ISA = ('Tie::StdScalar');
+}
+
+my @words = ( qw( new open closed 0 1 10 ), q{}, "caf\x{e9}", "\x{263a}" );
+enum 'Word', \@words;
+enum 'Status', [qw( new open closed )], intern => 1;
+
+my @many = map {"value$_"} 1 .. 500;
+enum 'Many', \@many;
+
+sub is_xs { !!B::svref_2object( $_[0] )->XSUB }
+
+sub shares_string {
+    my $sv = B::svref_2object( \$_[0] );
+    return $sv->FLAGS & B::SVf_IsCOW && $sv->LEN == 0;
+}
+
+{
+    my $type = find_type_constraint('Word');
+    ok( is_xs( $type->_compiled_type_constraint ), 'enum is checked in C' );
+
+    my $latin1 = "caf\x{e9}";
+    utf8::upgrade( my $upgraded = $latin1 );
+
+    my @values = (
+        @words, undef, \'new', [], 'old', 'Open', 'open ', "open\0", 10.0,
+        1.0, '1.0', $upgraded, "\x{263b}", "caf\x{c3}\x{a9}", 'value1',
+    );
+
+    for my $value (@values) {
+        my $desc = defined $value ? B::perlstring("$value") : 'undef';
+        my $expect = defined $value && !ref $value
+            && grep { $_ eq $value } @words;
+        is(
+            !!$type->check($value), !!$expect,
+            "Word check of $desc is right"
+        );
+    }
+
+    tie my $tied, 'TiedScalar';
+    $tied = 'open';
+    ok( $type->check($tied), 'tied scalars are checked' );
+    $tied = 'shut';
+    ok( !$type->check($tied), '... using their current value' );
+}
+
+{
+    my $type = find_type_constraint('Many');
+    ok( !( grep { !$type->check($_) } @many ), 'all values of a big enum pass' );
+    ok( !$type->check('value501'), '... and others fail' );
+}
+
+{
+    package Ticket;
+    use Moose;
+
+    has status => ( is => 'rw', isa => 'Status' );
+    has lazy_status => (
+        is      => 'ro',
+        isa     => 'Status',
+        lazy    => 1,
+        default => sub { join q{}, 'ne', 'w' },
+    );
+    has word => ( is => 'rw', isa => 'Word' );
+}
+
+for my $immutable ( 0, 1 ) {
+    Ticket->meta->make_immutable if $immutable;
+    my $desc = $immutable ? 'immutable' : 'mutable';
+
+    my $status = join q{}, 'op', 'en';
+    my $ticket = Ticket->new( status => $status, word => $status );
+    ok( shares_string( $ticket->{status} ), "$desc constructor stores a shared string" );
+    ok( !shares_string( $ticket->{word} ), '... only for types with intern set' );
+    is( $ticket->status, 'open', '... with the right value' );
+
+    $ticket->status('closed');
+    ok( shares_string( $ticket->{status} ), "$desc writer stores a shared string" );
+    is( $ticket->status, 'closed', '... with the right value' );
+
+    $ticket->lazy_status;
+    ok( shares_string( $ticket->{lazy_status} ), "$desc lazy default is shared" );
+
+    ok( !eval { $ticket->status('shut'); 1 }, 'bad values still fail' );
+    is( $ticket->status, 'closed', '... and are not stored' );
+
+    $ticket->{status} .= 'x';
+    is( $ticket->status, 'closedx', 'a shared string can be changed in place' );
+    is( Ticket->new( status => 'closed' )->status, 'closed', '... without changing others' );
+}
+
+{
+    my $exception = exception {
+        enum 'Renamed', [qw( a b )], name => 'Other', values => ['z'];
+    };
+    isa_ok(
+        $exception,
+        'Moose::Exception::InvalidTypeConstraintOptions',
+        'enum options other than intern'
+    );
+    like(
+        $exception,
+        qr/\QInvalid options for enum (name, values). The valid options are (intern)/,
+        '... are rejected'
+    );
+    ok( !find_type_constraint($_), "... and no $_ type is made" )
+        for qw( Renamed Other );
+
+    my $type = Moose::Util::TypeConstraints::create_enum_type_constraint(
+        'Direct', [qw( a b )], { intern => 1 },
+    );
+    is( $type->name, 'Direct', 'create_enum_type_constraint takes intern' );
+}
+
+done_testing;
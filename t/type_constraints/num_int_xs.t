@@ -0,0 +1,88 @@
+use strict;
+use warnings;
+
+use Test::More;
+
+use B ();
+use Moose::Util::TypeConstraints;
+use Scalar::Util qw( dualvar );
+
+{
+    package TiedScalar;
+    require Tie::Scalar;
+    our @ISA = ('Tie::StdScalar');
+}
+
+# the regexes Num and Int used to be written with
+sub num_regex {
+    my $val = shift;
+    return defined($val) && !ref($val)
+        && $val =~ /\A(?:[+-]?)(?=[0-9]|\.[0-9])[0-9]*(?:\.[0-9]+)?(?:[Ee](?:[+-]?[0-9]+))?\z/;
+}
+
+sub int_regex {
+    my $val = shift;
+    return defined($val) && !ref($val) && $val =~ /\A-?[0-9]+\z/;
+}
+
+my @values = (
+    undef, 0, 1, -1, 42, 1.5, -1.5, 1e20, 1e15, 1e14, 1e14 + 0.5, -0.0, 3.0,
+    0.1, 1e-5, 9**9**9, -9**9**9, ( 9**9**9 ) / ( 9**9**9 ),
+    ~0, -( ~0 >> 1 ) - 1,
+    dualvar( 1, 'x' ), dualvar( 0, '12' ), v1.2, \*STDOUT, *STDOUT, [], \1,
+    "1\n", "\x{661}", "1\x{100}", "12\0",
+);
+
+my @chars = ( '0', '1', '9', '+', '-', '.', 'e', 'E', ' ', 'x' );
+for my $length ( 0 .. 4 ) {
+    my @strings = (q{});
+    @strings = map { my $s = $_; map { $s . $_ } @chars } @strings
+        for 1 .. $length;
+    push @values, @strings;
+}
+
+my $num = find_type_constraint('Num');
+my $int = find_type_constraint('Int');
+
+my ( $num_ok, $int_ok ) = ( 1, 1 );
+for my $value (@values) {
+    my $copy = $value;
+    my $desc = defined $value ? B::perlstring("$value") : 'undef';
+
+    if ( !!$num->check($copy) ne !!num_regex($value) ) {
+        $num_ok = 0;
+        diag("Num check of $desc differs from the regex");
+    }
+    if ( !!$int->check($copy) ne !!int_regex($value) ) {
+        $int_ok = 0;
+        diag("Int check of $desc differs from the regex");
+    }
+}
+
+ok( $num_ok, 'Num accepts the same values as the regex it used to use' );
+ok( $int_ok, 'Int accepts the same values as the regex it used to use' );
+
+{
+    my $nv = 1.5;
+    ok( $num->check($nv), 'NV passes Num' );
+    ok( !( B::svref_2object( \$nv )->FLAGS & B::SVf_POK ), '... without being stringified' );
+
+    my $int_nv = 3.0;
+    ok( $int->check($int_nv), 'integral NV passes Int' );
+    ok( !( B::svref_2object( \$int_nv )->FLAGS & B::SVf_POK ), '... without being stringified' );
+}
+
+{
+    tie my $tied, 'TiedScalar';
+    $tied = 12;
+    ok( $int->check($tied), 'tied scalars are checked' );
+    $tied = 'x';
+    ok( !$num->check($tied), '... using their current value' );
+}
+
+{
+    local $_ = 42;
+    ok( Moose::Util::TypeConstraints::Builtins::_Int(), '_Int checks $_ by default' );
+}
+
+done_testing;
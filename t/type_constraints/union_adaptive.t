@@ -0,0 +1,166 @@
+use strict;
+use warnings;
+
+use Test::More;
+use Test::Fatal;
+
+use Moose::Util::TypeConstraints;
+
+{
+    package Thing;
+    sub new { bless {}, shift }
+}
+
+union 'Input', [qw( Str ArrayRef[Str] HashRef )], adaptive => 1;
+union 'Fixed', [qw( Str ArrayRef[Str] HashRef )];
+
+subtype 'NotInlined', as 'Int', where { $_ > 10 };
+union 'Mixed', [qw( NotInlined HashRef )], adaptive => 1;
+
+sub order { join ' ', map { $_->name } $_[0]->_ordered_type_constraints }
+
+my $input = find_type_constraint('Input');
+my $fixed = find_type_constraint('Fixed');
+
+ok( $input->adaptive,  'union created with adaptive is adaptive' );
+ok( !$fixed->adaptive, '... and others are not' );
+is( order($input), 'Str ArrayRef[Str] HashRef', 'members start in the given order' );
+is( order($fixed), 'Str ArrayRef[Str] HashRef', '... which never changes for other unions' );
+
+my @values = (
+    'x', q{}, 0, undef, [], ['a'], [ [] ], {}, { a => 1 }, \1, sub { },
+    Thing->new,
+);
+
+sub same_results {
+    my $type = shift;
+    for my $value (@values) {
+        return 0 if !!$type->check($value) ne !!$fixed->check($value);
+    }
+    return 1;
+}
+
+ok( same_results($input), 'adaptive union checks like a plain one' );
+
+$input->check( {} ) for 1 .. 2000;
+is(
+    order($input), 'HashRef Str ArrayRef[Str]',
+    'the member matching most often gets tried first'
+);
+is_deeply(
+    [ map { $_->name } @{ $input->type_constraints } ],
+    [ 'Str', 'ArrayRef[Str]', 'HashRef' ],
+    '... without changing type_constraints'
+);
+is( $input->find_type_for('x')->name, 'Str', 'find_type_for still works' );
+ok( same_results($input), '... and the union still checks the same values' );
+
+$input->check( ['a'] ) for 1 .. 5000;
+is(
+    order($input), 'ArrayRef[Str] HashRef Str',
+    'the order follows changes in the values being checked'
+);
+ok( same_results($input), '... and the union still checks the same values' );
+
+{
+    my $mixed = find_type_constraint('Mixed');
+    ok( $mixed->can_be_inlined, 'adaptive unions of non-inlinable types are inlined' );
+    $mixed->check( {} ) for 1 .. 2000;
+    is( order($mixed), 'HashRef NotInlined', '... and reordered' );
+    ok( $mixed->check(11),  '... and still pass good values' );
+    ok( !$mixed->check(5),  '... and fail bad ones' );
+    ok( !$mixed->check([]), '... of any kind' );
+}
+
+{
+    package Holder;
+    use Moose;
+    use Moose::Util::TypeConstraints;
+
+    subtype 'Upper', as 'Str', where { !/[a-z]/ };
+    coerce 'Upper', from 'Str', via { uc $_ };
+
+    subtype 'Pair', as 'ArrayRef', where { @{$_} == 2 };
+    coerce 'Pair', from 'Str', via { [ split /,/, $_ ] };
+
+    union 'UpperOrPair', [qw( Upper Pair )], adaptive => 1;
+
+    has input => ( is => 'rw', isa => 'Input' );
+    has coerced => ( is => 'rw', isa => 'UpperOrPair', coerce => 1 );
+}
+
+for my $immutable ( 0, 1 ) {
+    Holder->meta->make_immutable if $immutable;
+    my $desc = $immutable ? 'immutable' : 'mutable';
+
+    my $holder = Holder->new( input => {} );
+    $holder->input( {} ) for 1 .. 2000;
+    is( ref $holder->input, 'HASH', "$desc writer accepts values" );
+    like(
+        exception { $holder->input( \1 ) },
+        qr/Input/,
+        "$desc writer rejects values of no member"
+    );
+}
+
+{
+    my $union = find_type_constraint('UpperOrPair');
+    my $holder = Holder->new;
+
+    $holder->coerced('a,b');
+    is( $holder->coerced, 'A,B', 'coercions are tried in the given order' );
+
+    $union->check( [ 1, 2 ] ) for 1 .. 2000;
+    is( order($union), 'Pair Upper', 'after the union is reordered' );
+
+    $holder->coerced('a,b');
+    is_deeply( $holder->coerced, [qw( a b )], '... coercions follow its order' );
+}
+
+{
+    subtype 'ShortInput',
+        as 'Input',
+        where { !ref $_ || @{$_} < 3 },
+        inline_as {
+            $_[0]->parent->_inline_check( $_[1] )
+                . " && ( !ref $_[1] || \@{ $_[1] } < 3 )";
+        };
+
+    package HasShortInput;
+    use Moose;
+    has input => ( is => 'rw', isa => 'ShortInput' );
+    __PACKAGE__->meta->make_immutable;
+}
+
+{
+    my $holder = HasShortInput->new( input => ['a'] );
+    is_deeply(
+        $holder->input, ['a'],
+        'a subtype can embed the inlined check of an adaptive union parent'
+    );
+    is( $holder->input('x'), 'x', '... which accepts other members' );
+    like(
+        exception { $holder->input( \1 ) },
+        qr/ShortInput/,
+        '... and rejects values of no member'
+    );
+}
+
+{
+    my $exception = exception {
+        union 'Misspelled', [qw( Str ArrayRef )], adaptiv => 1;
+    };
+    isa_ok(
+        $exception,
+        'Moose::Exception::InvalidTypeConstraintOptions',
+        'union options other than adaptive'
+    );
+    like(
+        $exception,
+        qr/\QInvalid options for union (adaptiv). The valid options are (adaptive)/,
+        '... are rejected'
+    );
+    ok( !find_type_constraint('Misspelled'), '... and no type is made' );
+}
+
+done_testing;
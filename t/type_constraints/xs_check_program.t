@@ -0,0 +1,135 @@
+use strict;
+use warnings;
+
+use Test::More;
+use Test::Fatal;
+
+# the C checks are what is being tested, whatever the environment asks for
+BEGIN { delete $ENV{MOOSE_NO_XS_TYPE_CHECKS} }
+
+use B ();
+use Moose::Util::TypeConstraints;
+
+{
+    package Foo;
+    sub new { bless {}, shift }
+
+    package Bar;
+    our @ISA = ('Foo');
+
+    package Liar;
+    sub new { bless {}, shift }
+    sub isa { $_[1] eq 'Foo' || $_[0]->SUPER::isa( $_[1] ) }
+
+    package TiedArray;
+    require Tie::Array;
+    our @ISA = ('Tie::StdArray');
+}
+
+subtype 'Positive', as 'Int', where { $_ > 0 };
+subtype 'Small',    as 'Positive', where { $_ < 100 };
+subtype 'Even',     as 'Small', where { $_[0] % 2 == 0 };
+
+enum 'Color', [qw( red green blue )];
+subtype 'Warm', as 'Color', where { $_ eq 'red' };
+
+class_type 'Foo';
+subtype 'NamedFoo', as 'Foo', where { 1 };
+
+subtype 'SmallList',   as 'ArrayRef[Small]', where { @{$_} < 4 };
+subtype 'SmallHash',   as 'HashRef[Small]',  where { keys %{$_} < 4 };
+subtype 'MaybeSmall',  as 'Maybe[Small]',    where { 1 };
+subtype 'SmallMatrix', as 'ArrayRef[SmallList]', where { 1 };
+
+my @types = qw( Small Even Warm NamedFoo SmallList SmallHash MaybeSmall SmallMatrix );
+
+my @values = (
+    undef, 0, 1, 2, 3, 99, 100, -5, 1.5, '42', 'x', q{}, "2\n",
+    qw( red green yellow ),
+    \1, [], [ 1, 2 ], [ 1, 0 ], [ 1, 2, 3, 4 ], [ undef ], [ [2], [4] ],
+    [ [ 2, 200 ] ], {}, { a => 1 }, { a => 0 }, { a => undef },
+    Foo->new, Bar->new, Liar->new, sub { }, \*STDOUT,
+);
+
+sub is_xs { !!B::svref_2object( $_[0] )->XSUB }
+
+sub perl_check {
+    my $type = shift;
+    local $ENV{MOOSE_NO_XS_TYPE_CHECKS} = 1;
+    return $type->_actually_compile_type_constraint;
+}
+
+for my $name (@types) {
+    my $type = find_type_constraint($name);
+    my $xs   = $type->_compiled_type_constraint;
+    my $perl = perl_check($type);
+
+    ok( is_xs($xs),    "$name is checked in C" );
+    ok( !is_xs($perl), '... unless MOOSE_NO_XS_TYPE_CHECKS is set' );
+    is( B::svref_2object($xs)->GV->NAME, $name, '... and named after the type' );
+
+    for my $value (@values) {
+        my $desc = defined $value ? "$value" : 'undef';
+        is(
+            $xs->($value), $perl->($value),
+            "$name gives the same result as the perl check for $desc"
+        );
+    }
+}
+
+{
+    my $check = find_type_constraint('SmallList')->_compiled_type_constraint;
+
+    tie my @tied, 'TiedArray';
+    @tied = ( 1, 2 );
+    ok( $check->( \@tied ), 'tied arrays are checked' );
+    push @tied, 0;
+    ok( !$check->( \@tied ), '... including their elements' );
+
+    my %hash = ( a => 1, b => 2, c => 3 );
+    my $first = each %hash;
+    ok(
+        find_type_constraint('SmallHash')->check( \%hash ),
+        'hash ref checked'
+    );
+    is( ( each %hash ), $first, '... which resets its iterator, like values does' );
+}
+
+{
+    my @seen;
+    subtype 'Spy', as 'Str', where {
+        push @seen, [ $_, $_[0] ];
+        $_[0] = 'changed';
+        $_ = 'changed';
+        1;
+    };
+    subtype 'SpyChild', as 'Spy', where { push @seen, [ $_, $_[0] ]; 1 };
+
+    my $value = 'value';
+    local $_ = 'outer';
+    ok( find_type_constraint('SpyChild')->check($value), 'check passes' );
+    is_deeply(
+        \@seen,
+        [ [qw( value value )], [qw( changed changed )] ],
+        'constraints get the value as $_ and $_[0], like the perl closure passes them'
+    );
+    is( $value, 'value', '... but not the value itself' );
+    is( $_,     'outer', '... and $_ is restored' );
+}
+
+{
+    subtype 'Dies', as 'Int', where { die "no good\n" };
+
+    is(
+        exception { find_type_constraint('Dies')->check(1) },
+        "no good\n",
+        'exceptions from constraints propagate'
+    );
+    is(
+        exception { find_type_constraint('Dies')->check('x') },
+        undef,
+        '... and constraints are not called once a parent fails'
+    );
+}
+
+done_testing;
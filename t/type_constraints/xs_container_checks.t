@@ -0,0 +1,98 @@
+use strict;
+use warnings;
+
+use Test::More;
+use Moose::Util::TypeConstraints;
+
+{
+    package TiedArray;
+    require Tie::Array;
+    our @ISA = ('Tie::StdArray');
+
+    package TiedHash;
+    require Tie::Hash;
+    our @ISA = ('Tie::StdHash');
+
+    package TiedScalar;
+    require Tie::Scalar;
+    our @ISA = ('Tie::StdScalar');
+}
+
+sub tc { Moose::Util::TypeConstraints::find_or_create_isa_type_constraint(shift) }
+
+my @holes;
+$holes[2] = 1;
+
+tie my @tied_array, 'TiedArray';
+@tied_array = ( 1, 2 );
+
+tie my %tied_hash, 'TiedHash';
+%tied_hash = ( a => 1 );
+
+tie my $tied_scalar, 'TiedScalar';
+$tied_scalar = 42;
+
+my @containers = (
+    [], [ 1, 2, 3 ], [ 1, 'x' ], [ 1, 1.0 ], [ 1, 1.5 ], [undef], \@holes,
+    [ '1', "1\n" ], [ 1, [] ], [$tied_scalar], \@tied_array,
+    {}, { a => 1 }, { a => 'x' }, { a => undef }, { a => \1 },
+    { a => $tied_scalar }, \%tied_hash,
+);
+
+for my $param (qw( Int Str Num Bool Maybe[Int] Defined ArrayRef )) {
+    my $member = tc($param);
+
+    for my $container (qw( ArrayRef HashRef )) {
+        my $name = "$container\[$param\]";
+        my $type = tc($name);
+        my $elements = $container eq 'ArrayRef'
+            ? sub { @{ $_[0] } }
+            : sub { values %{ $_[0] } };
+
+        like(
+            $type->_inline_check('$value'),
+            qr/_xs_all_/,
+            "$name is checked in C"
+        );
+
+        for my $i ( 0 .. $#containers ) {
+            my $value  = $containers[$i];
+            my $expect = ref($value) eq ( $container eq 'ArrayRef' ? 'ARRAY' : 'HASH' )
+                && !grep { !$member->check($_) } $elements->($value);
+
+            is(
+                !!$type->check($value), !!$expect,
+                "$name check of container $i is right"
+            );
+        }
+    }
+}
+
+{
+    my $type = tc('ArrayRef[Int]');
+    my @big = ( 1 .. 10_000 );
+    ok( $type->check( \@big ), 'large array passes' );
+    push @big, 'x';
+    ok( !$type->check( \@big ), '... until an element fails' );
+}
+
+{
+    my %hash = ( a => 1, b => 2, c => 'x' );
+    my $first = each %hash;
+    ok( !tc('HashRef[Int]')->check( \%hash ), 'hash with a bad value fails' );
+    is( ( each %hash ), $first, '... and its iterator is reset, like values does' );
+}
+
+{
+    subtype 'MyInt', as 'Int', inline_as { $_[0]->parent->_inline_check( $_[1] ) };
+    my $type = tc('ArrayRef[MyInt]');
+    unlike(
+        $type->_inline_check('$value'),
+        qr/_xs_all_/,
+        'types the C code does not know are checked by perl'
+    );
+    ok( $type->check( [ 1, 2 ] ),  '... which passes good values' );
+    ok( !$type->check( [ 1, 'x' ] ), '... and fails bad ones' );
+}
+
+done_testing;
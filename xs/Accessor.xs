@@ -0,0 +1,40 @@
+#include "mop.h"
+
+MODULE = Moose::Meta::Method::Accessor   PACKAGE = Moose::Meta::Method::Accessor
+
+PROTOTYPES: DISABLE
+
+SV *
+_new_xs_reader(slot_name, fallback)
+    SV *slot_name
+    SV *fallback
+    CODE:
+        RETVAL = mop_new_slot_accessor(aTHX_ mop_xs_slot_reader, slot_name, fallback);
+    OUTPUT:
+        RETVAL
+
+SV *
+_new_xs_writer(slot_name, fallback, type_name)
+    SV *slot_name
+    SV *fallback
+    SV *type_name
+    CODE:
+        RETVAL = mop_new_checked_slot_accessor(aTHX_ mop_xs_slot_writer, slot_name, fallback, type_name);
+        if (!RETVAL) {
+            XSRETURN_UNDEF;
+        }
+    OUTPUT:
+        RETVAL
+
+SV *
+_new_xs_accessor(slot_name, fallback, type_name)
+    SV *slot_name
+    SV *fallback
+    SV *type_name
+    CODE:
+        RETVAL = mop_new_checked_slot_accessor(aTHX_ mop_xs_slot_accessor, slot_name, fallback, type_name);
+        if (!RETVAL) {
+            XSRETURN_UNDEF;
+        }
+    OUTPUT:
+        RETVAL
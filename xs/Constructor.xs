@@ -0,0 +1,340 @@
+#include "mop.h"
+
+typedef enum {
+    DEFAULT_NONE,
+    DEFAULT_VALUE,
+    DEFAULT_CODE,
+    DEFAULT_BUILDER,
+} default_kind_t;
+
+/* one per attribute, in the order the perl constructor initializes them */
+typedef struct {
+    SV  *slot;              /* prehashed keys, owned by mop.c */
+    U32  slot_hash;
+    SV  *init_arg;          /* NULL if the attribute has no init_arg */
+    U32  init_arg_hash;
+    SV  *initializer;       /* perl code initializing this attribute from
+                             * $params, NULL if there's nothing to do */
+    default_kind_t default_kind;
+    SV  *default_value;     /* the value, the sub or the builder's name */
+    SV  *trigger;
+    mop_builtin_tc_t tc;
+    bool maybe;
+    bool in_c;              /* whether we can initialize it ourselves */
+    bool required;
+} ctor_attr_t;
+
+typedef struct {
+    SV  *class_name;
+    SV  *fallback;          /* the perl constructor */
+    SV  *buildargs;         /* perl code turning @_ into $params */
+    bool buildargs_in_c;    /* whether that's Moose::Object::BUILDARGS */
+    SV  *body;              /* perl code doing the rest given $params */
+    I32  num_attrs;
+    ctor_attr_t *attrs;
+    AV  *builds;            /* fully qualified BUILD method names */
+} ctor_t;
+
+#define CONSTRUCTOR(cv)  ((ctor_t *)CvXSUBANY(cv).any_ptr)
+
+XS_EXTERNAL(mop_xs_constructor);
+
+STATIC int
+free_constructor (pTHX_ SV *sv, MAGIC *mg)
+{
+    ctor_t *ctor = (ctor_t *)mg->mg_ptr;
+    I32 i;
+    PERL_UNUSED_ARG(sv);
+
+    for (i = 0; i < ctor->num_attrs; i++) {
+        ctor_attr_t *attr = &ctor->attrs[i];
+        SvREFCNT_dec(attr->initializer);
+        SvREFCNT_dec(attr->default_value);
+        SvREFCNT_dec(attr->trigger);
+    }
+
+    SvREFCNT_dec(ctor->class_name);
+    SvREFCNT_dec(ctor->fallback);
+    SvREFCNT_dec(ctor->buildargs);
+    SvREFCNT_dec(ctor->body);
+    SvREFCNT_dec(ctor->builds);
+    Safefree(ctor->attrs);
+    Safefree(ctor);
+
+    return 0;
+}
+
+STATIC MGVTBL constructor_vtbl = {
+    NULL, /* get */
+    NULL, /* set */
+    NULL, /* len */
+    NULL, /* clear */
+    free_constructor, /* free */
+};
+
+/* a copy of $spec->{$key}, or NULL if it's missing or undef */
+STATIC SV *
+spec_value (pTHX_ HV *spec, const char *key)
+{
+    SV **svp = hv_fetch(spec, key, strlen(key), 0);
+
+    return svp && SvOK(*svp) ? newSVsv(*svp) : NULL;
+}
+
+/* $spec->{$key} itself, which may be undef */
+STATIC SV *
+spec_scalar (pTHX_ HV *spec, const char *key)
+{
+    SV **svp = hv_fetch(spec, key, strlen(key), 0);
+
+    return svp ? *svp : &PL_sv_undef;
+}
+
+STATIC HV *
+spec_hash (pTHX_ SV *sv)
+{
+    if (!SvROK(sv) || SvTYPE(SvRV(sv)) != SVt_PVHV) {
+        croak("constructor specs must be hash references");
+    }
+
+    return (HV *)SvRV(sv);
+}
+
+STATIC AV *
+spec_array (pTHX_ HV *spec, const char *key)
+{
+    SV **svp = hv_fetch(spec, key, strlen(key), 0);
+
+    if (!svp || !SvROK(*svp) || SvTYPE(SvRV(*svp)) != SVt_PVAV) {
+        croak("the %s in a constructor spec must be an array reference", key);
+    }
+
+    return (AV *)SvRV(*svp);
+}
+
+STATIC void
+parse_attr_spec (pTHX_ ctor_attr_t *attr, HV *spec)
+{
+    mop_prehashed_key_t key;
+    const char *kind;
+
+    Zero(attr, 1, ctor_attr_t);
+
+    key = mop_prehash_key(aTHX_ spec_scalar(aTHX_ spec, "slot"));
+    attr->slot      = mop_prehashed_key_for(key);
+    attr->slot_hash = mop_prehashed_hash_for(key);
+
+    if (SvOK(spec_scalar(aTHX_ spec, "init_arg"))) {
+        key = mop_prehash_key(aTHX_ spec_scalar(aTHX_ spec, "init_arg"));
+        attr->init_arg      = mop_prehashed_key_for(key);
+        attr->init_arg_hash = mop_prehashed_hash_for(key);
+    }
+
+    attr->initializer = spec_value(aTHX_ spec, "initializer");
+    attr->trigger     = attr->init_arg ? spec_value(aTHX_ spec, "trigger") : NULL;
+    attr->in_c        = SvTRUE(spec_scalar(aTHX_ spec, "in_c"));
+
+    if (!attr->in_c) {
+        return;
+    }
+
+    /* types we don't know are left to perl */
+    if (!mop_parse_builtin_tc(aTHX_ spec_scalar(aTHX_ spec, "type"), &attr->tc, &attr->maybe)) {
+        attr->in_c = FALSE;
+        return;
+    }
+
+    attr->required = SvTRUE(spec_scalar(aTHX_ spec, "required"));
+
+    if (SvOK(spec_scalar(aTHX_ spec, "default_kind"))) {
+        kind = SvPV_nolen(spec_scalar(aTHX_ spec, "default_kind"));
+
+        attr->default_kind  = strEQ(kind, "value")   ? DEFAULT_VALUE
+                            : strEQ(kind, "code")    ? DEFAULT_CODE
+                            : strEQ(kind, "builder") ? DEFAULT_BUILDER
+                            :                          DEFAULT_NONE;
+        attr->default_value = newSVsv(spec_scalar(aTHX_ spec, "default"));
+    }
+}
+
+STATIC SV *
+new_constructor (pTHX_ SV *spec_ref)
+{
+    HV *spec = spec_hash(aTHX_ spec_ref);
+    AV *attrs = spec_array(aTHX_ spec, "attributes");
+    CV *cv = newXS(NULL, mop_xs_constructor, __FILE__);
+    ctor_t *ctor;
+    I32 i;
+
+    Newxz(ctor, 1, ctor_t);
+    CvXSUBANY(cv).any_ptr = ctor;
+    sv_magicext((SV *)cv, NULL, PERL_MAGIC_ext, &constructor_vtbl, (char *)ctor, 0);
+
+    ctor->class_name = spec_value(aTHX_ spec, "class_name");
+    ctor->fallback   = spec_value(aTHX_ spec, "fallback");
+    ctor->buildargs  = spec_value(aTHX_ spec, "buildargs");
+    ctor->buildargs_in_c = SvTRUE(spec_scalar(aTHX_ spec, "buildargs_in_c"));
+    ctor->body       = spec_value(aTHX_ spec, "body");
+    ctor->builds     = (AV *)SvREFCNT_inc((SV *)spec_array(aTHX_ spec, "builds"));
+
+    Newxz(ctor->attrs, av_len(attrs) + 1, ctor_attr_t);
+    for (i = 0; i <= av_len(attrs); i++) {
+        parse_attr_spec(aTHX_ &ctor->attrs[i], spec_hash(aTHX_ *av_fetch(attrs, i, 1)));
+        ctor->num_attrs++;
+    }
+
+    return newRV_noinc((SV *)cv);
+}
+
+/* calls code with one or two arguments, returning its result in scalar
+ * context (or NULL, in void context) */
+STATIC SV *
+call_with (pTHX_ SV *code, I32 flags, SV *arg1, SV *arg2)
+{
+    dSP;
+    SV *ret;
+
+    PUSHMARK(SP);
+    XPUSHs(arg1);
+    if (arg2) {
+        XPUSHs(arg2);
+    }
+    PUTBACK;
+
+    if (flags & G_DISCARD) {
+        (void)call_sv(code, flags);
+        return NULL;
+    }
+
+    (void)call_sv(code, flags | G_SCALAR);
+    SPAGAIN;
+    ret = POPs;
+    PUTBACK;
+
+    return ret;
+}
+
+/* does what the perl constructor does for this attribute, returning FALSE
+ * if the perl initializer has to do it instead: for required attributes
+ * which are missing, values failing the type constraint, and type checked
+ * defaults from subs or builders (which we couldn't call twice) */
+STATIC bool
+init_attr (pTHX_ ctor_attr_t *attr, SV *instance, HV *params)
+{
+    HE *he;
+    SV *value;
+
+    if (attr->init_arg && (he = hv_fetch_ent(params, attr->init_arg, 0, attr->init_arg_hash))) {
+        value = HeVAL(he);
+    }
+    else if (attr->required) {
+        return FALSE;
+    }
+    else {
+        switch (attr->default_kind) {
+            case DEFAULT_NONE:
+                return TRUE;
+            case DEFAULT_VALUE:
+                value = attr->default_value;
+                break;
+            case DEFAULT_CODE:
+            case DEFAULT_BUILDER:
+                if (attr->tc != MOP_TC_NONE) {
+                    return FALSE;
+                }
+                value = call_with(aTHX_ attr->default_value,
+                                  attr->default_kind == DEFAULT_BUILDER ? G_METHOD : 0,
+                                  instance, NULL);
+                break;
+            default:
+                return FALSE;
+        }
+    }
+
+    if (!mop_check_builtin_tc(aTHX_ attr->tc, attr->maybe, value)) {
+        return FALSE;
+    }
+
+    (void)hv_store_ent((HV *)SvRV(instance), attr->slot, newSVsv(value), attr->slot_hash);
+
+    return TRUE;
+}
+
+XS_EXTERNAL(mop_xs_constructor)
+{
+    dVAR;
+    dXSARGS;
+    ctor_t *ctor = CONSTRUCTOR(cv);
+    SV *params_ref, *instance;
+    HV *params;
+    SV **svp;
+    bool odd = FALSE;
+    I32 i;
+
+    /* subclasses, and calls on an instance, are left to the perl code */
+    if (items < 1 || SvROK(ST(0)) || SvGMAGICAL(ST(0)) || !sv_eq(ST(0), ctor->class_name)) {
+        XSRETURN(mop_call_fallback(aTHX_ ctor->fallback, ax));
+    }
+
+    /* errors and warnings come from the perl code, so they're reported
+     * from the right place */
+    params_ref = ctor->buildargs_in_c ? mop_buildargs(aTHX_ &ST(1), items - 1, &odd) : NULL;
+
+    if (!params_ref || odd) {
+        PUSHMARK(MARK);
+        (void)call_sv(ctor->buildargs, G_SCALAR);
+        params_ref = ST(0);
+    }
+
+    if (!SvROK(params_ref) || SvTYPE(SvRV(params_ref)) != SVt_PVHV || SvRMAGICAL(SvRV(params_ref))) {
+        ST(0) = call_with(aTHX_ ctor->body, 0, ctor->class_name, params_ref);
+        XSRETURN(1);
+    }
+
+    params = (HV *)SvRV(params_ref);
+
+    instance = sv_2mortal(newRV_noinc((SV *)newHV()));
+    (void)sv_bless(instance, gv_stashsv(ctor->class_name, GV_ADD));
+
+    for (i = 0; i < ctor->num_attrs; i++) {
+        ctor_attr_t *attr = &ctor->attrs[i];
+
+        if ((!attr->in_c || !init_attr(aTHX_ attr, instance, params)) && attr->initializer) {
+            (void)call_with(aTHX_ attr->initializer, G_VOID | G_DISCARD, instance, params_ref);
+        }
+    }
+
+    for (i = 0; i < ctor->num_attrs; i++) {
+        ctor_attr_t *attr = &ctor->attrs[i];
+        HE *he;
+
+        if (attr->trigger && hv_exists_ent(params, attr->init_arg, attr->init_arg_hash)) {
+            he = hv_fetch_ent((HV *)SvRV(instance), attr->slot, 0, attr->slot_hash);
+            (void)call_with(aTHX_ attr->trigger, G_VOID | G_DISCARD, instance,
+                            he ? HeVAL(he) : &PL_sv_undef);
+        }
+    }
+
+    if (av_len(ctor->builds) >= 0
+     && !((svp = hv_fetchs(params, "__no_BUILD__", 0)) && SvTRUE(*svp))) {
+        for (i = 0; i <= av_len(ctor->builds); i++) {
+            (void)call_with(aTHX_ *av_fetch(ctor->builds, i, 1), G_VOID | G_DISCARD | G_METHOD,
+                            instance, params_ref);
+        }
+    }
+
+    ST(0) = instance;
+    XSRETURN(1);
+}
+
+MODULE = Moose::Meta::Method::Constructor   PACKAGE = Moose::Meta::Method::Constructor
+
+PROTOTYPES: DISABLE
+
+SV *
+_new_xs_constructor(spec)
+    SV *spec
+    CODE:
+        RETVAL = new_constructor(aTHX_ spec);
+    OUTPUT:
+        RETVAL
@@ -0,0 +1,169 @@
+#include "mop.h"
+
+/* Delegations of immutable classes whose attribute is read by a plain
+ * reader. These fetch the slot themselves and call the delegated method on
+ * its value with the arguments already on the stack, instead of calling the
+ * reader and then the method from perl.
+ *
+ * Objects of other classes only take the short cut while the reader they
+ * would call is the same one as the class's. Anything else, including a
+ * missing, undefined or unblessed value, is handed to the perl delegation so
+ * that lazy defaults and errors are unchanged. */
+
+typedef struct {
+    SV  *key;           /* prehashed key for the slot */
+    U32  hash;          /* its precomputed hash */
+    HV  *stash;         /* the class the delegation was made for */
+    SV  *reader;        /* name of the attribute's reader */
+    SV  *method;        /* name of the method to call on the value */
+    AV  *curried;       /* arguments to pass before the caller's */
+    SV  *fallback;      /* the perl implementation */
+} delegation_t;
+
+#define DELEGATION(cv)  ((delegation_t *)CvXSUBANY(cv).any_ptr)
+
+STATIC int
+free_delegation (pTHX_ SV *sv, MAGIC *mg)
+{
+    delegation_t *delegation = (delegation_t *)mg->mg_ptr;
+    PERL_UNUSED_ARG(sv);
+
+    SvREFCNT_dec((SV *)delegation->stash);
+    SvREFCNT_dec(delegation->reader);
+    SvREFCNT_dec(delegation->method);
+    SvREFCNT_dec((SV *)delegation->curried);
+    SvREFCNT_dec(delegation->fallback);
+    Safefree(delegation);
+
+    return 0;
+}
+
+STATIC MGVTBL delegation_vtbl = {
+    NULL, /* get */
+    NULL, /* set */
+    NULL, /* len */
+    NULL, /* clear */
+    free_delegation, /* free */
+};
+
+STATIC CV *
+reader_in (pTHX_ delegation_t *delegation, HV *stash)
+{
+    GV *gv = gv_fetchmeth(stash, SvPVX(delegation->reader), SvCUR(delegation->reader), 0);
+    return gv ? GvCV(gv) : NULL;
+}
+
+/* the instance hash of the invocant, if its slot can be read directly */
+STATIC HV *
+delegation_instance (pTHX_ delegation_t *delegation, SV *self)
+{
+    HV *obj, *stash;
+    CV *reader;
+
+    if (!SvROK(self)) {
+        return NULL;
+    }
+
+    obj = (HV *)SvRV(self);
+    if (SvTYPE(obj) != SVt_PVHV || SvRMAGICAL(obj) || !SvOBJECT(obj)) {
+        return NULL;
+    }
+
+    stash = SvSTASH(obj);
+    if (stash == delegation->stash) {
+        return obj;
+    }
+
+    /* a subclass may have its own reader */
+    reader = reader_in(aTHX_ delegation, stash);
+
+    return reader && reader == reader_in(aTHX_ delegation, delegation->stash) ? obj : NULL;
+}
+
+XS_EXTERNAL(mop_xs_delegation)
+{
+    dVAR;
+    dXSARGS;
+    delegation_t *delegation = DELEGATION(cv);
+    I32 ncurried = av_len(delegation->curried) + 1;
+    HV *obj;
+    HE *he;
+    SV *proxy;
+    I32 i;
+
+    if (items < 1 || !(obj = delegation_instance(aTHX_ delegation, ST(0)))
+     || !(he = hv_fetch_ent(obj, delegation->key, 0, delegation->hash))) {
+        XSRETURN(mop_call_fallback(aTHX_ delegation->fallback, ax));
+    }
+
+    proxy = HeVAL(he);
+    if (SvGMAGICAL(proxy) || !SvOK(proxy) || (SvROK(proxy) && !SvOBJECT(SvRV(proxy)))) {
+        XSRETURN(mop_call_fallback(aTHX_ delegation->fallback, ax));
+    }
+
+    /* the perl version calls the method on a copy of the value, which also
+     * keeps it alive if the method clears the slot */
+    ST(0) = sv_mortalcopy(proxy);
+
+    if (ncurried) {
+        SV **curried = AvARRAY(delegation->curried);
+
+        EXTEND(SP, ncurried);
+        for (i = items - 1; i > 0; i--) {
+            ST(i + ncurried) = ST(i);
+        }
+        for (i = 0; i < ncurried; i++) {
+            ST(i + 1) = curried[i];
+        }
+    }
+
+    PUSHMARK(PL_stack_base + ax - 1);
+    PL_stack_sp = PL_stack_base + ax + items + ncurried - 1;
+    (void)call_sv(delegation->method, GIMME_V | G_METHOD);
+
+    XSRETURN((I32)(PL_stack_sp - PL_stack_base) - ax + 1);
+}
+
+MODULE = Moose::Meta::Method::Delegation   PACKAGE = Moose::Meta::Method::Delegation
+
+PROTOTYPES: DISABLE
+
+SV *
+_new_xs_delegation(class_name, slot_name, reader, method, curried, fallback)
+    SV *class_name
+    SV *slot_name
+    SV *reader
+    SV *method
+    AV *curried
+    SV *fallback
+    PREINIT:
+        delegation_t *delegation;
+        mop_prehashed_key_t key;
+        CV *xsub;
+        const char *reader_pv;
+        STRLEN reader_len;
+        I32 i;
+    CODE:
+        key = mop_prehash_key(aTHX_ slot_name);
+        reader_pv = SvPV(reader, reader_len);
+
+        Newx(delegation, 1, delegation_t);
+        delegation->key      = mop_prehashed_key_for(key);
+        delegation->hash     = mop_prehashed_hash_for(key);
+        delegation->stash    = (HV *)SvREFCNT_inc_simple_NN((SV *)gv_stashsv(class_name, GV_ADD));
+        delegation->reader   = newSVpvn(reader_pv, reader_len);
+        delegation->method   = newSVsv(method);
+        delegation->curried  = newAV();
+        delegation->fallback = newSVsv(fallback);
+
+        for (i = 0; i <= av_len(curried); i++) {
+            SV **svp = av_fetch(curried, i, 0);
+            av_push(delegation->curried, svp ? newSVsv(*svp) : newSV(0));
+        }
+
+        xsub = newXS(NULL, mop_xs_delegation, __FILE__);
+        CvXSUBANY(xsub).any_ptr = delegation;
+        sv_magicext((SV *)xsub, NULL, PERL_MAGIC_ext, &delegation_vtbl, (char *)delegation, 0);
+        RETVAL = newRV_noinc((SV *)xsub);
+    OUTPUT:
+        RETVAL
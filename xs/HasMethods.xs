@@ -5,41 +5,84 @@ SV *mop_method_metaclass;
 SV *mop_associated_metaclass;
 SV *mop_wrap;
 
+/* the code ref a cached method stands for, read from the method object's
+ * body slot where it holds one, so the body() reader need not be called */
+static SV *
+mop_method_body(pTHX_ SV *const method)
+{
+    SV *body;
+
+    if (!sv_derived_from(method, "Class::MOP::Method")) {
+        return method;
+    }
+
+    if (SvTYPE(SvRV(method)) == SVt_PVHV && !SvRMAGICAL(SvRV(method))) {
+        HE *const he = hv_fetch_ent((HV *)SvRV(method), KEY_FOR(body), 0, HASH_FOR(body));
+
+        if (he && SvROK(HeVAL(he))) {
+            return HeVAL(he);
+        }
+    }
+
+    /* $method_object->body() */
+    body = mop_call0(aTHX_ method, KEY_FOR(body));
+
+    return body;
+}
+
+/* the code in the stash under the given name, if any */
+static CV *
+mop_stash_code(pTHX_ HV *const stash, HE *const entry)
+{
+    HE *const he = hv_fetch_ent(stash, hv_iterkeysv(entry), 0, HeHASH(entry));
+    GV *gv;
+
+    if (!he) {
+        return NULL;
+    }
+
+    gv = (GV *)HeVAL(he);
+
+    /* expand the gv into a real typeglob if it contains a stub function or a
+     * constant, as mop_get_package_symbols does */
+    if (!isGV(gv)) {
+        STRLEN keylen;
+        const char *const key = HePV(entry, keylen);
+
+        gv_init(gv, stash, key, keylen, GV_ADDMULTI | (HeKUTF8(entry) ? SVf_UTF8 : 0));
+        return GvCV(gv);
+    }
+
+    return GvCVu(gv);
+}
+
+/* drop the cached methods which are no longer in the stash. only the cached
+ * names are looked up, so this costs the same however many other subs the
+ * package has */
 static void
 mop_update_method_map(pTHX_ HV *const stash, HV *const map)
 {
-    char *method_name;
-    I32   method_name_len;
-    SV   *method;
-    HV   *symbols;
-
-    symbols = mop_get_all_package_symbols(stash, TYPE_FILTER_CODE);
-    sv_2mortal((SV*)symbols);
+    HE *entry;
 
     (void)hv_iterinit(map);
-    while ((method = hv_iternextsv(map, &method_name, &method_name_len))) {
+    while ((entry = hv_iternext(map))) {
+        SV *const method = HeVAL(entry);
         SV *body;
-        SV *stash_slot;
+        CV *code;
 
         if (!SvROK(method)) {
             continue;
         }
 
-        if (sv_derived_from(method, "Class::MOP::Method")) {
-            /* $method_object->body() */
-            body = mop_call0(aTHX_ method, KEY_FOR(body));
-        }
-        else {
-            body = method;
-        }
+        body = mop_method_body(aTHX_ method);
+        code = mop_stash_code(aTHX_ stash, entry);
 
-        stash_slot = *hv_fetch(symbols, method_name, method_name_len, TRUE);
-        if (SvROK(stash_slot) && ((CV*)SvRV(body)) == ((CV*)SvRV(stash_slot))) {
+        if (code && SvROK(body) && (CV *)SvRV(body) == code) {
             continue;
         }
 
         /* delete $map->{$method_name} */
-        (void)hv_delete(map, method_name, method_name_len, G_DISCARD);
+        (void)hv_delete_ent(map, hv_iterkeysv(entry), G_DISCARD, HeHASH(entry));
     }
 }
 
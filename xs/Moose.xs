@@ -101,6 +101,12 @@ XS_EXTERNAL(boot_Class__MOP__Class);
 XS_EXTERNAL(boot_Class__MOP__Attribute);
 XS_EXTERNAL(boot_Class__MOP__Instance);
 XS_EXTERNAL(boot_Moose__Meta__Role__Application__ToInstance);
+XS_EXTERNAL(boot_Moose__Meta__Method__Accessor);
+XS_EXTERNAL(boot_Moose__Meta__Method__Constructor);
+XS_EXTERNAL(boot_Moose__Meta__Method__Delegation);
+XS_EXTERNAL(boot_Moose__Meta__Method__Accessor__Native);
+XS_EXTERNAL(boot_Moose__Object);
+XS_EXTERNAL(boot_Moose__Meta__TypeConstraint);
 
 MODULE = Moose  PACKAGE = Moose::Exporter
 
@@ -121,6 +127,12 @@ BOOT:
     MOP_CALL_BOOT (boot_Class__MOP__Attribute);
     MOP_CALL_BOOT (boot_Class__MOP__Instance);
     MOP_CALL_BOOT (boot_Moose__Meta__Role__Application__ToInstance);
+    MOP_CALL_BOOT (boot_Moose__Meta__Method__Accessor);
+    MOP_CALL_BOOT (boot_Moose__Meta__Method__Constructor);
+    MOP_CALL_BOOT (boot_Moose__Meta__Method__Delegation);
+    MOP_CALL_BOOT (boot_Moose__Meta__Method__Accessor__Native);
+    MOP_CALL_BOOT (boot_Moose__Object);
+    MOP_CALL_BOOT (boot_Moose__Meta__TypeConstraint);
 
 void
 _flag_as_reexport (SV *sv)
@@ -146,3 +158,17 @@ _RegexpRef (SV *sv=NULL)
         RETVAL = SvRXOK(sv);
     OUTPUT:
         RETVAL
+
+bool
+_Num (SV *sv=NULL)
+    ALIAS:
+        _Int = 1
+    INIT:
+        if (!items) {
+            sv = DEFSV;
+        }
+    CODE:
+        SvGETMAGIC(sv);
+        RETVAL = mop_is_num(aTHX_ sv, ix);
+    OUTPUT:
+        RETVAL
@@ -0,0 +1,427 @@
+#include "mop.h"
+
+/* The most common native trait methods of immutable classes. Each works on
+ * the slot's value directly and returns what the generated perl method
+ * would. Anything else, such as a missing slot (which may need a lazy
+ * default), a value of the wrong kind, a tied or magical value, a bad
+ * argument or an integer overflow, is handed to the perl method so that
+ * errors are unchanged. */
+
+typedef enum {
+    NATIVE_ARRAY_COUNT,
+    NATIVE_ARRAY_ELEMENTS,
+    NATIVE_ARRAY_GET,
+    NATIVE_ARRAY_IS_EMPTY,
+    NATIVE_HASH_COUNT,
+    NATIVE_HASH_EXISTS,
+    NATIVE_HASH_GET,
+    NATIVE_HASH_IS_EMPTY,
+    NATIVE_HASH_KEYS,
+    NATIVE_COUNTER_INC,
+    NATIVE_COUNTER_DEC,
+    NATIVE_BOOL_TOGGLE,
+    NATIVE_STRING_LENGTH,
+} native_op_t;
+
+static const struct {
+    const char *name;
+    native_op_t op;
+} native_ops[] = {
+    { "Array::count",    NATIVE_ARRAY_COUNT    },
+    { "Array::elements", NATIVE_ARRAY_ELEMENTS },
+    { "Array::get",      NATIVE_ARRAY_GET      },
+    { "Array::is_empty", NATIVE_ARRAY_IS_EMPTY },
+    { "Hash::count",     NATIVE_HASH_COUNT     },
+    { "Hash::exists",    NATIVE_HASH_EXISTS    },
+    { "Hash::get",       NATIVE_HASH_GET       },
+    { "Hash::is_empty",  NATIVE_HASH_IS_EMPTY  },
+    { "Hash::keys",      NATIVE_HASH_KEYS      },
+    { "Counter::inc",    NATIVE_COUNTER_INC    },
+    { "Counter::dec",    NATIVE_COUNTER_DEC    },
+    { "Bool::toggle",    NATIVE_BOOL_TOGGLE    },
+    { "String::length",  NATIVE_STRING_LENGTH  },
+};
+
+typedef struct {
+    SV  *key;           /* prehashed key for the slot */
+    U32  hash;          /* its precomputed hash */
+    native_op_t op;
+    AV  *curried;       /* arguments to pass before the caller's */
+    SV  *fallback;      /* the perl implementation */
+} native_t;
+
+#define NATIVE(cv)  ((native_t *)CvXSUBANY(cv).any_ptr)
+
+STATIC int
+free_native (pTHX_ SV *sv, MAGIC *mg)
+{
+    native_t *native = (native_t *)mg->mg_ptr;
+    PERL_UNUSED_ARG(sv);
+
+    SvREFCNT_dec((SV *)native->curried);
+    SvREFCNT_dec(native->fallback);
+    Safefree(native);
+
+    return 0;
+}
+
+STATIC MGVTBL native_vtbl = {
+    NULL, /* get */
+    NULL, /* set */
+    NULL, /* len */
+    NULL, /* clear */
+    free_native, /* free */
+};
+
+/* the array or hash the slot refers to, if it can be used directly */
+STATIC SV *
+native_container (pTHX_ SV *value, svtype type)
+{
+    SV *container;
+
+    if (!SvROK(value) || SvAMAGIC(value)) {
+        return NULL;
+    }
+
+    container = SvRV(value);
+
+    return SvTYPE(container) == type && !SvRMAGICAL(container) ? container : NULL;
+}
+
+/* an index which the perl version's /^-?\d+$/ check would accept */
+STATIC bool
+native_valid_index (pTHX_ SV *index)
+{
+    const char *pv, *end;
+    STRLEN len;
+
+    if (SvGMAGICAL(index) || SvROK(index)) {
+        return FALSE;
+    }
+
+    if (SvIOK(index)) {
+        return !SvIsUV(index);
+    }
+
+    if (!SvPOK(index)) {
+        return FALSE;
+    }
+
+    pv  = SvPV_nomg(index, len);
+    end = pv + len;
+
+    if (len && end[-1] == '\n') {
+        end--;
+    }
+    if (pv < end && *pv == '-') {
+        pv++;
+    }
+    if (pv == end) {
+        return FALSE;
+    }
+    for (; pv < end; pv++) {
+        if (!isDIGIT(*pv)) {
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
+STATIC bool
+native_valid_key (pTHX_ SV *key)
+{
+    return !SvGMAGICAL(key) && SvOK(key);
+}
+
+STATIC SV *
+native_copy (pTHX_ SV *value)
+{
+    return value ? sv_mortalcopy(value) : &PL_sv_undef;
+}
+
+STATIC SV *
+native_hash_value (pTHX_ HV *hv, SV *key)
+{
+    HE *he = hv_fetch_ent(hv, key, 0, 0);
+    return native_copy(aTHX_ he ? HeVAL(he) : NULL);
+}
+
+/* adds amount to the integer in value, unless that isn't exactly what perl
+ * would do */
+STATIC bool
+native_add (pTHX_ SV *value, SV *amount, bool negate, IV *result)
+{
+    IV iv, by = 1;
+
+    if (SvROK(value) || SvREADONLY(value) || !SvIOK(value) || SvIsUV(value)) {
+        return FALSE;
+    }
+
+    if (amount && SvOK(amount)) {
+        if (SvGMAGICAL(amount) || SvROK(amount) || !SvIOK(amount) || SvIsUV(amount)) {
+            return FALSE;
+        }
+        by = SvIVX(amount);
+    }
+
+    if (negate) {
+        if (by == IV_MIN) {
+            return FALSE;
+        }
+        by = -by;
+    }
+
+    iv = SvIVX(value);
+    if (by > 0 ? iv > IV_MAX - by : iv < IV_MIN - by) {
+        return FALSE;
+    }
+
+    *result = iv + by;
+    sv_setiv_mg(value, *result);
+
+    return TRUE;
+}
+
+/* runs the operation with the nargs arguments at args, leaving its results
+ * at ST(0). returns how many there are, or -1 to use the perl version */
+STATIC I32
+native_run (pTHX_ native_t *native, SV *value, SV **args, I32 nargs, I32 ax, I32 gimme)
+{
+    SV *container;
+    I32 i, count;
+    IV result;
+
+    switch (native->op) {
+    case NATIVE_ARRAY_COUNT:
+    case NATIVE_ARRAY_IS_EMPTY:
+        if (nargs || !(container = native_container(aTHX_ value, SVt_PVAV))) {
+            return -1;
+        }
+        count = av_len((AV *)container) + 1;
+        ST(0) = sv_2mortal(newSViv(native->op == NATIVE_ARRAY_COUNT ? count : !count));
+        return 1;
+
+    case NATIVE_ARRAY_ELEMENTS:
+        if (nargs || !(container = native_container(aTHX_ value, SVt_PVAV))) {
+            return -1;
+        }
+        count = av_len((AV *)container) + 1;
+        if (gimme != G_LIST) {
+            ST(0) = sv_2mortal(newSViv(count));
+            return 1;
+        }
+        {
+            dSP;
+            EXTEND(SP, count);
+        }
+        for (i = 0; i < count; i++) {
+            SV **svp = av_fetch((AV *)container, i, 0);
+            ST(i) = native_copy(aTHX_ svp ? *svp : NULL);
+        }
+        return count;
+
+    case NATIVE_ARRAY_GET:
+        if (nargs != 1 || !native_valid_index(aTHX_ args[0])
+         || !(container = native_container(aTHX_ value, SVt_PVAV))) {
+            return -1;
+        }
+        {
+            SV **svp = av_fetch((AV *)container, SvIV_nomg(args[0]), 0);
+            ST(0) = native_copy(aTHX_ svp ? *svp : NULL);
+        }
+        return 1;
+
+    case NATIVE_HASH_COUNT:
+    case NATIVE_HASH_IS_EMPTY:
+        if (nargs || !(container = native_container(aTHX_ value, SVt_PVHV))) {
+            return -1;
+        }
+        /* keys resets the iterator */
+        (void)hv_iterinit((HV *)container);
+        count = HvUSEDKEYS((HV *)container);
+        ST(0) = sv_2mortal(newSViv(native->op == NATIVE_HASH_COUNT ? count : !count));
+        return 1;
+
+    case NATIVE_HASH_KEYS:
+        if (nargs || !(container = native_container(aTHX_ value, SVt_PVHV))) {
+            return -1;
+        }
+        (void)hv_iterinit((HV *)container);
+        count = HvUSEDKEYS((HV *)container);
+        if (gimme != G_LIST) {
+            ST(0) = sv_2mortal(newSViv(count));
+            return 1;
+        }
+        {
+            dSP;
+            HE *he;
+            EXTEND(SP, count);
+            for (i = 0; (he = hv_iternext((HV *)container)); i++) {
+                ST(i) = hv_iterkeysv(he);
+            }
+            return i;
+        }
+
+    case NATIVE_HASH_EXISTS:
+        if (nargs != 1 || !native_valid_key(aTHX_ args[0])
+         || !(container = native_container(aTHX_ value, SVt_PVHV))) {
+            return -1;
+        }
+        ST(0) = hv_exists_ent((HV *)container, args[0], 0) ? &PL_sv_yes : &PL_sv_no;
+        return 1;
+
+    case NATIVE_HASH_GET:
+        if (nargs < 1 || !(container = native_container(aTHX_ value, SVt_PVHV))) {
+            return -1;
+        }
+        for (i = 0; i < nargs; i++) {
+            if (!native_valid_key(aTHX_ args[i])) {
+                return -1;
+            }
+        }
+        /* a slice in scalar context gives its last element */
+        if (nargs == 1 || gimme != G_LIST) {
+            ST(0) = native_hash_value(aTHX_ (HV *)container, args[nargs - 1]);
+            return 1;
+        }
+        /* the results overwrite the arguments, so look them all up first */
+        {
+            SV *buffer = sv_2mortal(newSV(nargs * sizeof(SV *)));
+            SV **values = (SV **)SvPVX(buffer);
+            dSP;
+
+            for (i = 0; i < nargs; i++) {
+                values[i] = native_hash_value(aTHX_ (HV *)container, args[i]);
+            }
+            EXTEND(SP, nargs);
+            for (i = 0; i < nargs; i++) {
+                ST(i) = values[i];
+            }
+        }
+        return nargs;
+
+    case NATIVE_COUNTER_INC:
+    case NATIVE_COUNTER_DEC:
+        if (nargs > 1
+         || !native_add(aTHX_ value, nargs ? args[0] : NULL, native->op == NATIVE_COUNTER_DEC, &result)) {
+            return -1;
+        }
+        ST(0) = sv_2mortal(newSViv(result));
+        return 1;
+
+    case NATIVE_BOOL_TOGGLE:
+        if (nargs || SvROK(value) || SvREADONLY(value)) {
+            return -1;
+        }
+        result = SvTRUE_nomg(value) ? 0 : 1;
+        sv_setiv_mg(value, result);
+        ST(0) = sv_2mortal(newSViv(result));
+        return 1;
+
+    case NATIVE_STRING_LENGTH:
+        if (nargs || SvROK(value)) {
+            return -1;
+        }
+        if (!SvOK(value)) {
+            ST(0) = &PL_sv_undef;
+        }
+        else {
+            STRLEN len;
+            const char *pv = SvPV_nomg(value, len);
+            if (SvUTF8(value)) {
+                len = utf8_length((U8 *)pv, (U8 *)pv + len);
+            }
+            ST(0) = sv_2mortal(newSViv((IV)len));
+        }
+        return 1;
+    }
+
+    return -1;
+}
+
+XS_EXTERNAL(mop_xs_native_method)
+{
+    dVAR;
+    dXSARGS;
+    native_t *native = NATIVE(cv);
+    I32 ncurried = av_len(native->curried) + 1;
+    SV *few_args[4];
+    SV **args = few_args;
+    I32 nargs = items - 1 + ncurried;
+    HV *obj;
+    HE *he;
+    I32 count;
+
+    if (items < 1 || !(obj = mop_slot_instance(aTHX_ ST(0)))
+     || !(he = hv_fetch_ent(obj, native->key, 0, native->hash))
+     || SvGMAGICAL(HeVAL(he))) {
+        XSRETURN(mop_call_fallback(aTHX_ native->fallback, ax));
+    }
+
+    if (ncurried) {
+        if (nargs > 4) {
+            args = (SV **)SvPVX(sv_2mortal(newSV(nargs * sizeof(SV *))));
+        }
+        Copy(AvARRAY(native->curried), args, ncurried, SV *);
+        Copy(&ST(1), args + ncurried, items - 1, SV *);
+    }
+    else {
+        args = &ST(1);
+    }
+
+    count = native_run(aTHX_ native, HeVAL(he), args, nargs, ax, GIMME_V);
+    if (count < 0) {
+        XSRETURN(mop_call_fallback(aTHX_ native->fallback, ax));
+    }
+
+    XSRETURN(count);
+}
+
+MODULE = Moose::Meta::Method::Accessor::Native   PACKAGE = Moose::Meta::Method::Accessor::Native
+
+PROTOTYPES: DISABLE
+
+SV *
+_new_xs_native_method(op_name, slot_name, curried, fallback)
+    SV *op_name
+    SV *slot_name
+    AV *curried
+    SV *fallback
+    PREINIT:
+        native_t *native;
+        mop_prehashed_key_t key;
+        const char *name;
+        CV *xsub;
+        size_t i;
+    CODE:
+        name = SvPV_nolen(op_name);
+        for (i = 0; i < sizeof(native_ops) / sizeof(native_ops[0]); i++) {
+            if (strEQ(native_ops[i].name, name)) {
+                break;
+            }
+        }
+        if (i == sizeof(native_ops) / sizeof(native_ops[0])) {
+            XSRETURN_UNDEF;
+        }
+
+        key = mop_prehash_key(aTHX_ slot_name);
+
+        Newx(native, 1, native_t);
+        native->key      = mop_prehashed_key_for(key);
+        native->hash     = mop_prehashed_hash_for(key);
+        native->op       = native_ops[i].op;
+        native->curried  = newAV();
+        native->fallback = newSVsv(fallback);
+
+        for (i = 0; (I32)i <= av_len(curried); i++) {
+            SV **svp = av_fetch(curried, i, 0);
+            av_push(native->curried, svp ? newSVsv(*svp) : newSV(0));
+        }
+
+        xsub = newXS(NULL, mop_xs_native_method, __FILE__);
+        CvXSUBANY(xsub).any_ptr = native;
+        sv_magicext((SV *)xsub, NULL, PERL_MAGIC_ext, &native_vtbl, (char *)native, 0);
+        RETVAL = newRV_noinc((SV *)xsub);
+    OUTPUT:
+        RETVAL
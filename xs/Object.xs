@@ -0,0 +1,259 @@
+#define NEED_mg_findext
+#define NEED_sv_unmagicext
+#include "mop.h"
+
+/* Each Moose class keeps the names of all the roles it does, including
+ * roles composed into those roles and roles of its superclasses, in magic
+ * on its stash. The set is built by Moose::Meta::Class::_role_set and lets
+ * the XS does() and DOES() answer without asking the metaclass.
+ *
+ * A set is thrown away when any role is added to a class or role, when a
+ * Moose metaclass is created, when a method or @ISA of the class or one of
+ * its superclasses changes, or when its metaclass goes away. The sets of
+ * immutable classes only go away with the class, or when it is made mutable,
+ * as their roles are never looked up again either. */
+
+typedef struct {
+    HV   *roles;        /* role name => 1 */
+    SV   *meta;         /* weak reference to the metaclass */
+    UV    roles_gen;    /* role_sets_gen when the set was built */
+    UV    method_gen;   /* method cache generation of the class then */
+    bool  frozen;       /* built for an immutable class */
+    bool  answers_does; /* the metaclass has the standard does_role */
+} role_set_t;
+
+STATIC UV role_sets_gen = 0;
+
+STATIC int
+free_role_set (pTHX_ SV *sv, MAGIC *mg)
+{
+    role_set_t *set = (role_set_t *)mg->mg_ptr;
+    PERL_UNUSED_ARG(sv);
+
+    SvREFCNT_dec((SV *)set->roles);
+    SvREFCNT_dec(set->meta);
+    Safefree(set);
+
+    return 0;
+}
+
+STATIC MGVTBL role_set_vtbl = {
+    NULL, /* get */
+    NULL, /* set */
+    NULL, /* len */
+    NULL, /* clear */
+    free_role_set, /* free */
+};
+
+STATIC MAGIC *
+role_set_magic (pTHX_ HV *stash)
+{
+    return SvMAGICAL((SV *)stash)
+         ? mg_findext((SV *)stash, PERL_MAGIC_ext, &role_set_vtbl)
+         : NULL;
+}
+
+/* the role set of the class, unless it has gone stale */
+STATIC role_set_t *
+valid_role_set (pTHX_ HV *stash)
+{
+    MAGIC *mg = role_set_magic(aTHX_ stash);
+    role_set_t *set;
+
+    if (!mg) {
+        return NULL;
+    }
+
+    set = (role_set_t *)mg->mg_ptr;
+    if (!SvROK(set->meta)) {
+        return NULL;
+    }
+
+    if (!set->frozen
+     && (set->roles_gen != role_sets_gen
+      || set->method_gen != mop_stash_method_gen(aTHX_ stash))) {
+        return NULL;
+    }
+
+    return set;
+}
+
+STATIC void
+forget_role_set (pTHX_ HV *stash)
+{
+    if (role_set_magic(aTHX_ stash)) {
+        sv_unmagicext((SV *)stash, PERL_MAGIC_ext, &role_set_vtbl);
+    }
+}
+
+MODULE = Moose::Object  PACKAGE = Moose::Object
+
+PROTOTYPES: DISABLE
+
+void
+does (self, ...)
+        SV *self
+    PREINIT:
+        SV *role_name = items > 1 ? ST(1) : &PL_sv_undef;
+        HV *stash = NULL;
+        role_set_t *set;
+        CV *fallback;
+    PPCODE:
+        if (SvROK(self)) {
+            if (SvOBJECT(SvRV(self))) {
+                stash = SvSTASH(SvRV(self));
+            }
+        }
+        else if (SvPOK(self) && !SvGMAGICAL(self)) {
+            stash = gv_stashsv(self, 0);
+        }
+
+        if (stash && !SvGMAGICAL(role_name) && SvOK(role_name) && !SvROK(role_name)
+         && (set = valid_role_set(aTHX_ stash)) && set->answers_does) {
+            ST(0) = sv_2mortal(newSViv(hv_exists_ent(set->roles, role_name, 0) ? 1 : 0));
+            XSRETURN(1);
+        }
+
+        /* anything else is left to the perl version */
+        fallback = get_cv("Moose::Object::_does", 0);
+        if (!fallback) {
+            croak("Moose::Object::_does is not defined");
+        }
+
+        XSRETURN(mop_call_fallback(aTHX_ (SV *)fallback, ax));
+
+void
+DOES (self, ...)
+        SV *self
+    PREINIT:
+        SV *role_name = items > 1 ? ST(1) : &PL_sv_undef;
+        HV *stash = NULL;
+        role_set_t *set;
+        GV *does;
+        CV *fallback;
+    PPCODE:
+        if (SvROK(self)) {
+            if (SvOBJECT(SvRV(self))) {
+                stash = SvSTASH(SvRV(self));
+            }
+        }
+        else if (SvPOK(self) && !SvGMAGICAL(self)) {
+            stash = gv_stashsv(self, 0);
+        }
+
+        /* a role in the set is enough, as long as does() of the class is
+         * the one above, which would say the same */
+        if (stash && !SvGMAGICAL(role_name) && SvOK(role_name) && !SvROK(role_name)
+         && (set = valid_role_set(aTHX_ stash)) && set->answers_does
+         && hv_exists_ent(set->roles, role_name, 0)
+         && (does = gv_fetchmeth(stash, "does", 4, 0))
+         && CvISXSUB(GvCV(does)) && CvXSUB(GvCV(does)) == XS_Moose__Object_does) {
+            ST(0) = sv_2mortal(newSViv(1));
+            XSRETURN(1);
+        }
+
+        /* anything else, including classes, is left to the perl version */
+        fallback = get_cv("Moose::Object::_DOES", 0);
+        if (!fallback) {
+            croak("Moose::Object::_DOES is not defined");
+        }
+
+        XSRETURN(mop_call_fallback(aTHX_ (SV *)fallback, ax));
+
+SV *
+BUILDARGS (klass, ...)
+        SV *klass
+    PREINIT:
+        SV *params;
+        bool odd;
+    CODE:
+        params = mop_buildargs(aTHX_ &ST(1), items - 1, &odd);
+
+        if (!params) {
+            dSP;
+            PUSHMARK(SP);
+            mXPUSHp("SingleParamsToNewMustBeHashRef", 30);
+            PUTBACK;
+            (void)call_pv("Moose::Util::throw_exception", G_VOID | G_DISCARD);
+        }
+
+        if (odd) {
+            dSP;
+            PUSHMARK(SP);
+            mXPUSHs(newSVpvf("The new() method for %" SVf " expects a hash reference or a"
+                             " key/value list. You passed an odd number of arguments",
+                             SVfARG(klass)));
+            PUTBACK;
+            (void)call_pv("Carp::carp", G_VOID | G_DISCARD);
+        }
+
+        RETVAL = SvREFCNT_inc(params);
+    OUTPUT:
+        RETVAL
+
+MODULE = Moose::Object  PACKAGE = Moose::Meta::Class
+
+SV *
+_cached_role_set (class_name, meta)
+        SV *class_name
+        SV *meta
+    PREINIT:
+        HV *stash;
+        role_set_t *set;
+    CODE:
+        stash = gv_stashsv(class_name, 0);
+
+        if (stash && SvROK(meta) && (set = valid_role_set(aTHX_ stash))
+         && SvRV(set->meta) == SvRV(meta)) {
+            RETVAL = newRV_inc((SV *)set->roles);
+        }
+        else {
+            RETVAL = &PL_sv_undef;
+        }
+    OUTPUT:
+        RETVAL
+
+void
+_cache_role_set (class_name, meta, roles, frozen, answers_does)
+        SV *class_name
+        SV *meta
+        HV *roles
+        bool frozen
+        bool answers_does
+    PREINIT:
+        HV *stash;
+        role_set_t *set;
+    CODE:
+        if (!SvROK(meta)) {
+            croak("Invalid metaclass");
+        }
+
+        stash = gv_stashsv(class_name, GV_ADD);
+        forget_role_set(aTHX_ stash);
+
+        Newx(set, 1, role_set_t);
+        set->roles        = (HV *)SvREFCNT_inc_simple_NN((SV *)roles);
+        set->meta         = newRV_inc(SvRV(meta));
+        set->roles_gen    = role_sets_gen;
+        set->method_gen   = mop_stash_method_gen(aTHX_ stash);
+        set->frozen       = frozen;
+        set->answers_does = answers_does;
+        sv_rvweaken(set->meta);
+
+        sv_magicext((SV *)stash, NULL, PERL_MAGIC_ext, &role_set_vtbl, (char *)set, 0);
+
+void
+_forget_role_set (class_name)
+        SV *class_name
+    PREINIT:
+        HV *stash;
+    CODE:
+        stash = gv_stashsv(class_name, 0);
+        if (stash) {
+            forget_role_set(aTHX_ stash);
+        }
+
+void
+_role_sets_changed ()
+    CODE:
+        role_sets_gen++;
@@ -0,0 +1,1021 @@
+#include "mop.h"
+
+/* the checks a type constraint and its parents do, lowered by
+ * Moose::Meta::TypeConstraint::_check_program into a list of ops which we
+ * run in order. every op knows the perl code doing the same check, which we
+ * call for anything we can't decide ourselves */
+
+/* the values of an enum, in a perfect hash table built once when the type
+ * is created: a first hash picks a bucket, and each bucket has a table of
+ * its own with a seed chosen so that its values don't collide. the values
+ * are shared hash key scalars, which copies of them share the string of */
+
+typedef struct {
+    U32  seed;
+    U32  mask;              /* size of its table - 1 */
+    U32  offset;            /* of its table in slots */
+} enum_bucket_t;
+
+typedef struct {
+    U32  seed;
+    U32  mask;              /* number of buckets - 1 */
+    enum_bucket_t *buckets;
+    SV **slots;
+} enum_table_t;
+
+#define ENUM_TABLE(cv)  ((enum_table_t *)CvXSUBANY(cv).any_ptr)
+
+XS_EXTERNAL(mop_xs_enum_check);
+
+/* FNV-1a, with murmur3's finalizer so that different seeds give unrelated
+ * hashes */
+STATIC U32
+enum_hash (U32 seed, const char *pv, STRLEN len, bool utf8)
+{
+    U32 h = 2166136261U ^ seed;
+    STRLEN i;
+
+    for (i = 0; i < len; i++) {
+        h ^= (U8)pv[i];
+        h *= 16777619U;
+    }
+
+    h ^= (U32)len ^ (utf8 ? 0x80000000U : 0);
+    h ^= h >> 16;
+    h *= 0x85ebca6bU;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35U;
+    h ^= h >> 16;
+
+    return h;
+}
+
+STATIC U32
+enum_table_size (U32 n)
+{
+    U32 size = 1;
+
+    while (size < n) {
+        size <<= 1;
+    }
+
+    return size;
+}
+
+STATIC U32
+enum_key_hash (U32 seed, SV *key)
+{
+    return enum_hash(seed, SvPVX(key), SvCUR(key), SvUTF8(key) ? TRUE : FALSE);
+}
+
+/* tries to place a bucket's keys in its table without collisions */
+STATIC bool
+enum_place_bucket (enum_table_t *table, enum_bucket_t *bucket, SV **keys, U32 num_keys)
+{
+    U32 i;
+
+    for (i = 0; i <= bucket->mask; i++) {
+        table->slots[bucket->offset + i] = NULL;
+    }
+
+    for (i = 0; i < num_keys; i++) {
+        SV **slot = &table->slots[bucket->offset + (enum_key_hash(bucket->seed, keys[i]) & bucket->mask)];
+
+        if (*slot) {
+            return FALSE;
+        }
+
+        *slot = keys[i];
+    }
+
+    return TRUE;
+}
+
+STATIC void
+free_enum_table (pTHX_ enum_table_t *table)
+{
+    U32 i, num_slots = table->buckets[table->mask].offset + table->buckets[table->mask].mask + 1;
+
+    for (i = 0; i < num_slots; i++) {
+        SvREFCNT_dec(table->slots[i]);
+    }
+
+    Safefree(table->slots);
+    Safefree(table->buckets);
+    Safefree(table);
+}
+
+STATIC enum_table_t *
+new_enum_table (pTHX_ AV *values)
+{
+    enum_table_t *table;
+    SV **keys, **bucket_keys;
+    U32 *counts;
+    U32 i, j, num_keys = 0, num_values = av_len(values) + 1, num_slots;
+
+    /* the keys, without duplicates, which share their strings so that
+     * equal ones have the same buffer */
+    Newx(keys, num_values > 0 ? num_values : 1, SV *);
+    for (i = 0; i < num_values; i++) {
+        SV **svp = av_fetch(values, i, 0);
+        STRLEN len;
+        const char *pv;
+        SV *key;
+
+        if (!svp) {
+            continue;
+        }
+
+        pv  = SvPV(*svp, len);
+        key = newSVpvn_share(pv, SvUTF8(*svp) ? -(I32)len : (I32)len, 0);
+        SvREADONLY_on(key);
+
+        for (j = 0; j < num_keys && SvPVX(keys[j]) != SvPVX(key); j++) {
+        }
+
+        if (j < num_keys) {
+            SvREFCNT_dec(key);
+        }
+        else {
+            keys[num_keys++] = key;
+        }
+    }
+
+    Newxz(table, 1, enum_table_t);
+    table->mask = enum_table_size(num_keys) - 1;
+    Newxz(table->buckets, table->mask + 1, enum_bucket_t);
+    Newxz(counts, table->mask + 1, U32);
+
+    /* a first level seed which spreads the keys well enough for the
+     * buckets' tables (sized as the square of their number of keys) to
+     * fit in four times the number of keys */
+    for (table->seed = 0; ; table->seed++) {
+        U32 total = 0;
+
+        Zero(counts, table->mask + 1, U32);
+        for (i = 0; i < num_keys; i++) {
+            counts[enum_key_hash(table->seed, keys[i]) & table->mask]++;
+        }
+        for (i = 0; i <= table->mask; i++) {
+            total += enum_table_size(counts[i] * counts[i]);
+        }
+
+        if (total <= 4 * (table->mask + 1) || table->seed >= 1000) {
+            break;
+        }
+    }
+
+    num_slots = 0;
+    for (i = 0; i <= table->mask; i++) {
+        table->buckets[i].offset = num_slots;
+        table->buckets[i].mask   = enum_table_size(counts[i] * counts[i]) - 1;
+        num_slots += table->buckets[i].mask + 1;
+    }
+    Newxz(table->slots, num_slots, SV *);
+
+    Newx(bucket_keys, num_keys > 0 ? num_keys : 1, SV *);
+    for (i = 0; i <= table->mask; i++) {
+        enum_bucket_t *bucket = &table->buckets[i];
+        U32 num_bucket_keys = 0;
+
+        for (j = 0; j < num_keys; j++) {
+            if ((enum_key_hash(table->seed, keys[j]) & table->mask) == i) {
+                bucket_keys[num_bucket_keys++] = keys[j];
+            }
+        }
+
+        /* distinct keys are placed by some seed, very quickly for small
+         * buckets, which all of them are */
+        while (!enum_place_bucket(table, bucket, bucket_keys, num_bucket_keys)) {
+            bucket->seed++;
+        }
+    }
+
+    Safefree(bucket_keys);
+    Safefree(counts);
+    Safefree(keys);
+
+    return table;
+}
+
+/* the shared copy of the value if it is one of the enum's, or NULL. like a
+ * perl hash lookup, this doesn't care whether the string is utf8 */
+STATIC SV *
+enum_lookup (pTHX_ enum_table_t *table, SV *value)
+{
+    STRLEN len;
+    const char *pv;
+    U8 *bytes = NULL;
+    bool utf8;
+    enum_bucket_t *bucket;
+    SV *key;
+
+    if (!SvOK(value) || SvROK(value)) {
+        return NULL;
+    }
+
+    pv   = SvPV_nomg(value, len);
+    utf8 = SvUTF8(value) ? TRUE : FALSE;
+
+    if (utf8) {
+        bytes = bytes_from_utf8((const U8 *)pv, &len, &utf8);
+        if ((const char *)bytes == pv) {
+            bytes = NULL;
+        }
+        else {
+            pv = (const char *)bytes;
+        }
+    }
+
+    bucket = &table->buckets[enum_hash(table->seed, pv, len, utf8) & table->mask];
+    key    = table->slots[bucket->offset + (enum_hash(bucket->seed, pv, len, utf8) & bucket->mask)];
+
+    if (key && (SvUTF8(key) ? TRUE : FALSE) != utf8) {
+        key = NULL;
+    }
+    if (key && !(SvCUR(key) == len && memEQ(SvPVX(key), pv, len))) {
+        key = NULL;
+    }
+
+    if (bytes) {
+        Safefree(bytes);
+    }
+
+    return key;
+}
+
+STATIC int
+free_enum_check (pTHX_ SV *sv, MAGIC *mg)
+{
+    PERL_UNUSED_ARG(sv);
+    free_enum_table(aTHX_ (enum_table_t *)mg->mg_ptr);
+    return 0;
+}
+
+STATIC MGVTBL enum_check_vtbl = {
+    NULL, /* get */
+    NULL, /* set */
+    NULL, /* len */
+    NULL, /* clear */
+    free_enum_check, /* free */
+};
+
+/* the table of an enum check made by _new_xs_check, or NULL */
+STATIC enum_table_t *
+enum_table_of (SV *check)
+{
+    CV *cv;
+
+    if (!SvROK(check) || SvTYPE(SvRV(check)) != SVt_PVCV) {
+        return NULL;
+    }
+
+    cv = (CV *)SvRV(check);
+
+    return CvISXSUB(cv) && CvXSUB(cv) == mop_xs_enum_check ? ENUM_TABLE(cv) : NULL;
+}
+
+/* does what the code inlined for enums does: defined, not a reference,
+ * and one of the values */
+XS_EXTERNAL(mop_xs_enum_check)
+{
+    dVAR;
+    dXSARGS;
+    SV *value;
+
+    if (items < 1) {
+        croak_xs_usage(cv, "value");
+    }
+
+    value = ST(0);
+    SvGETMAGIC(value);
+
+    ST(0) = enum_lookup(aTHX_ ENUM_TABLE(cv), value) ? &PL_sv_yes : &PL_sv_undef;
+    XSRETURN(1);
+}
+
+/* returns the shared copy of values which are in the enum, and any other
+ * value unchanged */
+XS_EXTERNAL(mop_xs_enum_intern)
+{
+    dVAR;
+    dXSARGS;
+    SV *value, *key;
+
+    if (items < 1) {
+        croak_xs_usage(cv, "value");
+    }
+
+    value = ST(0);
+    SvGETMAGIC(value);
+
+    if ((key = enum_lookup(aTHX_ ENUM_TABLE(cv), value))) {
+        ST(0) = key;
+    }
+    XSRETURN(1);
+}
+
+/* Class type checks remember their answer for the last few stashes they
+ * saw. An answer stays good until something changes what method lookups in
+ * the stash find (see mop_stash_method_gen), which covers both its isa method
+ * and its @ISA and those of its ancestors. */
+
+#define ISA_CACHE_SIZE 8
+
+typedef enum {
+    ISA_NO,
+    ISA_YES,
+    ISA_PERL,               /* the class has its own isa method */
+} isa_result_t;
+
+typedef struct {
+    SV  *stash;             /* a weak reference, so stashes can be freed */
+    UV   gen;
+    isa_result_t result;
+} isa_entry_t;
+
+typedef struct {
+    SV  *class_name;
+    SV  *fallback;          /* the perl code doing the same check */
+    CV  *universal_isa;
+    U32  next;              /* the entry to replace next */
+    isa_entry_t entries[ISA_CACHE_SIZE];
+} isa_cache_t;
+
+#define ISA_CACHE(cv)  ((isa_cache_t *)CvXSUBANY(cv).any_ptr)
+
+XS_EXTERNAL(mop_xs_isa_check);
+
+STATIC int
+free_isa_check (pTHX_ SV *sv, MAGIC *mg)
+{
+    isa_cache_t *cache = (isa_cache_t *)mg->mg_ptr;
+    U32 i;
+    PERL_UNUSED_ARG(sv);
+
+    for (i = 0; i < ISA_CACHE_SIZE; i++) {
+        SvREFCNT_dec(cache->entries[i].stash);
+    }
+
+    SvREFCNT_dec(cache->class_name);
+    SvREFCNT_dec(cache->fallback);
+    Safefree(cache);
+
+    return 0;
+}
+
+STATIC MGVTBL isa_check_vtbl = {
+    NULL, /* get */
+    NULL, /* set */
+    NULL, /* len */
+    NULL, /* clear */
+    free_isa_check, /* free */
+};
+
+/* the cache of a class check made by _new_xs_check, or NULL */
+STATIC isa_cache_t *
+isa_cache_of (SV *check)
+{
+    CV *cv;
+
+    if (!SvROK(check) || SvTYPE(SvRV(check)) != SVt_PVCV) {
+        return NULL;
+    }
+
+    cv = (CV *)SvRV(check);
+
+    return CvISXSUB(cv) && CvXSUB(cv) == mop_xs_isa_check ? ISA_CACHE(cv) : NULL;
+}
+
+/* does what the code inlined for class types does,
+ * blessed($value) && $value->isa($class), unless the object has its own isa
+ * method */
+STATIC isa_result_t
+isa_lookup (pTHX_ isa_cache_t *cache, SV *value)
+{
+    HV *stash;
+    GV *gv;
+    UV gen;
+    U32 i;
+    isa_entry_t *entry;
+    isa_result_t result;
+
+    if (SvGMAGICAL(value)) {
+        return ISA_PERL;
+    }
+
+    if (!SvROK(value) || !mop_is_sane_object(aTHX_ SvRV(value))) {
+        return ISA_NO;
+    }
+
+    stash = SvSTASH(SvRV(value));
+    gen   = mop_stash_method_gen(aTHX_ stash);
+
+    if (gen) {
+        for (i = 0; i < ISA_CACHE_SIZE; i++) {
+            entry = &cache->entries[i];
+            if (entry->stash && SvROK(entry->stash)
+             && SvRV(entry->stash) == (SV *)stash && entry->gen == gen) {
+                return entry->result;
+            }
+        }
+    }
+
+    gv = gv_fetchmeth(stash, "isa", 3, 0);
+    if (cache->universal_isa && gv && isGV(gv) && GvCV(gv) == cache->universal_isa) {
+        result = sv_derived_from(value, SvPV_nolen(cache->class_name)) ? ISA_YES : ISA_NO;
+    }
+    else {
+        result = ISA_PERL;
+    }
+
+    /* the lookups above give the stash its mro data if it had none */
+    if ((gen = mop_stash_method_gen(aTHX_ stash))) {
+        entry = &cache->entries[cache->next];
+        cache->next = (cache->next + 1) % ISA_CACHE_SIZE;
+
+        SvREFCNT_dec(entry->stash);
+        entry->stash  = sv_rvweaken(newRV_inc((SV *)stash));
+        entry->gen    = gen;
+        entry->result = result;
+    }
+
+    return result;
+}
+
+/* returns 1 or undef, or whatever the perl code returns for objects with
+ * their own isa method */
+XS_EXTERNAL(mop_xs_isa_check)
+{
+    dVAR;
+    dXSARGS;
+    isa_cache_t *cache = ISA_CACHE(cv);
+
+    if (items != 1) {
+        XSRETURN(mop_call_fallback(aTHX_ cache->fallback, ax));
+    }
+
+    switch (isa_lookup(aTHX_ cache, ST(0))) {
+        case ISA_YES:
+            ST(0) = &PL_sv_yes;
+            break;
+        case ISA_NO:
+            ST(0) = &PL_sv_undef;
+            break;
+        case ISA_PERL:
+            XSRETURN(mop_call_fallback(aTHX_ cache->fallback, ax));
+    }
+
+    XSRETURN(1);
+}
+
+typedef enum {
+    TC_OP_BUILTIN,          /* one of the builtin types, see mop_check_builtin_tc */
+    TC_OP_ISA,              /* a class type */
+    TC_OP_ENUM,             /* the values of an enum */
+    TC_OP_ALL_ARRAY,        /* ArrayRef[...], given an array ref */
+    TC_OP_ALL_HASH,         /* HashRef[...], given a hash ref */
+    TC_OP_MAYBE,            /* Maybe[...] */
+    TC_OP_PERL,             /* anything else */
+} tc_opcode_t;
+
+typedef struct tc_program_s tc_program_t;
+
+typedef struct {
+    tc_opcode_t opcode;
+    SV  *check;             /* the perl code for this op */
+    mop_builtin_tc_t tc;    /* TC_OP_BUILTIN */
+    bool maybe;
+    isa_cache_t *isa;       /* TC_OP_ISA: the cache of the class type's check */
+    SV  *enum_check;        /* TC_OP_ENUM: the enum's compiled check */
+    enum_table_t *values;
+    SV  *element_check;     /* TC_OP_ALL_*, TC_OP_MAYBE: the compiled check of
+                             * the type parameter */
+    tc_program_t *elements; /* its program, if it is one of ours */
+} tc_op_t;
+
+struct tc_program_s {
+    SV  *fallback;          /* the perl closure doing all the checks */
+    I32  num_ops;
+    tc_op_t *ops;
+};
+
+/* the state of a program running on one value. perl code gets called the
+ * way the closure built by _compile_subtype calls it, with a copy of the
+ * value in both $_[0] and a localized $_ */
+typedef struct {
+    SV  *value;
+    SV  *arg;               /* NULL until we first call perl */
+} tc_run_t;
+
+#define TC_PROGRAM(cv)  ((tc_program_t *)CvXSUBANY(cv).any_ptr)
+
+XS_EXTERNAL(mop_xs_type_check);
+
+STATIC bool tc_run_program (pTHX_ tc_program_t *program, SV *value);
+
+STATIC int
+free_program (pTHX_ SV *sv, MAGIC *mg)
+{
+    tc_program_t *program = (tc_program_t *)mg->mg_ptr;
+    I32 i;
+    PERL_UNUSED_ARG(sv);
+
+    for (i = 0; i < program->num_ops; i++) {
+        tc_op_t *op = &program->ops[i];
+        SvREFCNT_dec(op->check);
+        SvREFCNT_dec(op->enum_check);
+        SvREFCNT_dec(op->element_check);
+    }
+
+    SvREFCNT_dec(program->fallback);
+    Safefree(program->ops);
+    Safefree(program);
+
+    return 0;
+}
+
+STATIC MGVTBL program_vtbl = {
+    NULL, /* get */
+    NULL, /* set */
+    NULL, /* len */
+    NULL, /* clear */
+    free_program, /* free */
+};
+
+STATIC SV *
+spec_elem (pTHX_ AV *spec, I32 i)
+{
+    SV **svp = av_fetch(spec, i, 0);
+
+    if (!svp) {
+        croak("Invalid type check program");
+    }
+
+    return *svp;
+}
+
+STATIC bool
+is_code_ref (SV *sv)
+{
+    return SvROK(sv) && SvTYPE(SvRV(sv)) == SVt_PVCV;
+}
+
+STATIC void
+init_op (pTHX_ tc_op_t *op, AV *spec)
+{
+    const char *opname = SvPV_nolen(spec_elem(aTHX_ spec, 0));
+    SV *check = spec_elem(aTHX_ spec, 1);
+
+    if (!is_code_ref(check)) {
+        croak("Invalid type check program");
+    }
+
+    Zero(op, 1, tc_op_t);
+    op->check = newSVsv(check);
+
+    if (strEQ(opname, "builtin")) {
+        op->opcode = TC_OP_BUILTIN;
+        if (!mop_parse_builtin_tc(aTHX_ spec_elem(aTHX_ spec, 2), &op->tc, &op->maybe)) {
+            op->opcode = TC_OP_PERL;
+        }
+    }
+    else if (strEQ(opname, "isa")) {
+        /* the check keeps its cache alive */
+        op->opcode = TC_OP_ISA;
+        op->isa    = isa_cache_of(check);
+        if (!op->isa) {
+            op->opcode = TC_OP_PERL;
+        }
+    }
+    else if (strEQ(opname, "enum")) {
+        SV *enum_check = spec_elem(aTHX_ spec, 2);
+
+        /* the check keeps its table alive */
+        op->opcode = TC_OP_ENUM;
+        op->values = enum_table_of(enum_check);
+        if (op->values) {
+            op->enum_check = newSVsv(enum_check);
+        }
+        else {
+            op->opcode = TC_OP_PERL;
+        }
+    }
+    else if (strEQ(opname, "all_array") || strEQ(opname, "all_hash") || strEQ(opname, "maybe")) {
+        SV *element_check = spec_elem(aTHX_ spec, 2);
+        CV *element_cv;
+
+        if (!is_code_ref(element_check)) {
+            croak("Invalid type check program");
+        }
+
+        op->opcode = opname[0] == 'm' ? TC_OP_MAYBE
+                   : opname[4] == 'a' ? TC_OP_ALL_ARRAY
+                   :                    TC_OP_ALL_HASH;
+        op->element_check = newSVsv(element_check);
+
+        /* the element check keeps its program alive */
+        element_cv = (CV *)SvRV(element_check);
+        if (CvISXSUB(element_cv) && CvXSUB(element_cv) == mop_xs_type_check) {
+            op->elements = TC_PROGRAM(element_cv);
+        }
+    }
+    else if (strEQ(opname, "perl")) {
+        op->opcode = TC_OP_PERL;
+    }
+    else {
+        croak("Invalid type check program");
+    }
+}
+
+STATIC SV *
+new_type_check (pTHX_ AV *spec, SV *fallback)
+{
+    tc_program_t *program;
+    CV *cv = newXS(NULL, mop_xs_type_check, __FILE__);
+    I32 i, len = av_len(spec) + 1;
+
+    Newxz(program, 1, tc_program_t);
+    Newxz(program->ops, len > 0 ? len : 1, tc_op_t);
+    program->fallback = newSVsv(fallback);
+
+    CvXSUBANY(cv).any_ptr = program;
+    sv_magicext((SV *)cv, NULL, PERL_MAGIC_ext, &program_vtbl, (char *)program, 0);
+
+    for (i = 0; i < len; i++) {
+        SV *op_spec = spec_elem(aTHX_ spec, i);
+        tc_op_t *op = &program->ops[program->num_ops];
+
+        if (!SvROK(op_spec) || SvTYPE(SvRV(op_spec)) != SVt_PVAV) {
+            croak("Invalid type check program");
+        }
+
+        init_op(aTHX_ op, (AV *)SvRV(op_spec));
+        program->num_ops++;
+
+        /* Any, Item and friends don't check anything */
+        if (op->opcode == TC_OP_BUILTIN
+         && (op->tc == MOP_TC_NONE || op->tc == MOP_TC_ANY || op->tc == MOP_TC_ITEM)) {
+            SvREFCNT_dec(op->check);
+            program->num_ops--;
+        }
+    }
+
+    return newRV_noinc((SV *)cv);
+}
+
+/* calls code which checks a single value the way perl would */
+STATIC bool
+call_check (pTHX_ SV *check, SV *arg)
+{
+    dSP;
+    bool ok;
+
+    ENTER;
+    SAVETMPS;
+
+    PUSHMARK(SP);
+    XPUSHs(arg);
+    PUTBACK;
+
+    (void)call_sv(check, G_SCALAR);
+
+    SPAGAIN;
+    ok = SvTRUE(POPs);
+    PUTBACK;
+
+    FREETMPS;
+    LEAVE;
+
+    return ok;
+}
+
+/* calls the perl code for an op */
+STATIC bool
+call_op_check (pTHX_ tc_run_t *run, tc_op_t *op)
+{
+    if (!run->arg) {
+        ENTER;
+        SAVETMPS;
+        run->arg = sv_mortalcopy(run->value);
+        sv_setsv(save_scalar(PL_defgv), run->value);
+    }
+
+    return call_check(aTHX_ op->check, run->arg);
+}
+
+STATIC bool
+check_element (pTHX_ tc_op_t *op, SV *element)
+{
+    if (op->elements) {
+        return tc_run_program(aTHX_ op->elements, element);
+    }
+
+    return call_check(aTHX_ op->element_check, element);
+}
+
+/* plain containers, which we can walk without calling any perl code */
+STATIC SV *
+plain_container (pTHX_ SV *value, svtype type)
+{
+    SV *container;
+
+    if (SvGMAGICAL(value) || !SvROK(value)) {
+        return NULL;
+    }
+
+    container = SvRV(value);
+
+    if (SvTYPE(container) != type || SvOBJECT(container) || SvRMAGICAL(container)) {
+        return NULL;
+    }
+
+    return container;
+}
+
+STATIC bool
+check_all_array (pTHX_ tc_op_t *op, AV *av)
+{
+    I32 i;
+
+    /* the perl code called for the elements can change the array, so this
+     * looks at its size again every time, like foreach does */
+    for (i = 0; i <= av_len(av); i++) {
+        SV **svp = av_fetch(av, i, 0);
+
+        if (!check_element(aTHX_ op, svp ? *svp : &PL_sv_undef)) {
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
+STATIC bool
+check_all_hash (pTHX_ tc_op_t *op, HV *hv)
+{
+    I32 i, count = 0, num_values = HvUSEDKEYS(hv);
+    SV **values;
+    HE *he;
+    bool ok = TRUE;
+
+    /* like values %$hash, take all the values before calling perl code
+     * which could use the hash's iterator */
+    ENTER;
+    Newx(values, num_values > 0 ? num_values : 1, SV *);
+    SAVEFREEPV(values);
+
+    hv_iterinit(hv);
+    while (count < num_values && (he = hv_iternext(hv))) {
+        values[count++] = HeVAL(he);
+    }
+    hv_iterinit(hv);
+
+    for (i = 0; i < count && ok; i++) {
+        ok = check_element(aTHX_ op, values[i]);
+    }
+
+    LEAVE;
+
+    return ok;
+}
+
+/* returns whether the value passes the op, calling its perl code unless we
+ * know the answer */
+STATIC bool
+run_op (pTHX_ tc_run_t *run, tc_op_t *op)
+{
+    SV *value = run->value;
+    SV *container;
+
+    switch (op->opcode) {
+        case TC_OP_BUILTIN:
+            if (mop_check_builtin_tc(aTHX_ op->tc, op->maybe, value)) {
+                return TRUE;
+            }
+            break;
+        case TC_OP_ISA:
+            switch (isa_lookup(aTHX_ op->isa, value)) {
+                case ISA_YES:
+                    return TRUE;
+                case ISA_NO:
+                    return FALSE;
+                case ISA_PERL:
+                    break;
+            }
+            break;
+        case TC_OP_ENUM:
+            if (!SvGMAGICAL(value) && SvOK(value) && !SvROK(value)) {
+                return enum_lookup(aTHX_ op->values, value) != NULL;
+            }
+            break;
+        case TC_OP_ALL_ARRAY:
+            if ((container = plain_container(aTHX_ value, SVt_PVAV))) {
+                return check_all_array(aTHX_ op, (AV *)container);
+            }
+            break;
+        case TC_OP_ALL_HASH:
+            if ((container = plain_container(aTHX_ value, SVt_PVHV))) {
+                return check_all_hash(aTHX_ op, (HV *)container);
+            }
+            break;
+        case TC_OP_MAYBE:
+            if (!SvGMAGICAL(value)) {
+                return !SvOK(value) || check_element(aTHX_ op, value);
+            }
+            break;
+        case TC_OP_PERL:
+            break;
+    }
+
+    return call_op_check(aTHX_ run, op);
+}
+
+STATIC bool
+tc_run_program (pTHX_ tc_program_t *program, SV *value)
+{
+    tc_run_t run;
+    bool ok = TRUE;
+    I32 i;
+
+    run.value = value;
+    run.arg   = NULL;
+
+    for (i = 0; i < program->num_ops && ok; i++) {
+        ok = run_op(aTHX_ &run, &program->ops[i]);
+    }
+
+    /* undo the localization of $_ done by call_op_check */
+    if (run.arg) {
+        FREETMPS;
+        LEAVE;
+    }
+
+    return ok;
+}
+
+/* whether every element of a plain array or every value of a plain hash
+ * definitely passes a builtin type. FALSE means the perl code has to decide */
+STATIC bool
+all_elements_pass (pTHX_ SV *type_name, SV *value, svtype type)
+{
+    mop_builtin_tc_t tc;
+    bool maybe;
+    SV *container = plain_container(aTHX_ value, type);
+
+    if (!container || !mop_parse_builtin_tc(aTHX_ type_name, &tc, &maybe)) {
+        return FALSE;
+    }
+
+    if (type == SVt_PVAV) {
+        AV *av = (AV *)container;
+        I32 i, len = av_len(av);
+
+        for (i = 0; i <= len; i++) {
+            SV **svp = av_fetch(av, i, 0);
+
+            if (!mop_check_builtin_tc(aTHX_ tc, maybe, svp ? *svp : &PL_sv_undef)) {
+                return FALSE;
+            }
+        }
+    }
+    else {
+        HV *hv = (HV *)container;
+        HE *he;
+
+        hv_iterinit(hv);
+        while ((he = hv_iternext(hv))) {
+            if (!mop_check_builtin_tc(aTHX_ tc, maybe, HeVAL(he))) {
+                /* values %$hash leaves the iterator reset */
+                hv_iterinit(hv);
+                return FALSE;
+            }
+        }
+    }
+
+    return TRUE;
+}
+
+/* returns 1 or undef, like the closure built by _compile_subtype */
+XS_EXTERNAL(mop_xs_type_check)
+{
+    dVAR;
+    dXSARGS;
+    tc_program_t *program = TC_PROGRAM(cv);
+
+    if (items != 1) {
+        XSRETURN(mop_call_fallback(aTHX_ program->fallback, ax));
+    }
+
+    ST(0) = tc_run_program(aTHX_ program, ST(0)) ? &PL_sv_yes : &PL_sv_undef;
+    XSRETURN(1);
+}
+
+MODULE = Moose::Meta::TypeConstraint   PACKAGE = Moose::Meta::TypeConstraint
+
+PROTOTYPES: DISABLE
+
+SV *
+_new_xs_check(ops, fallback)
+    SV *ops
+    SV *fallback
+    CODE:
+        if (!SvROK(ops) || SvTYPE(SvRV(ops)) != SVt_PVAV || !is_code_ref(fallback)) {
+            croak("Invalid type check program");
+        }
+        RETVAL = new_type_check(aTHX_ (AV *)SvRV(ops), fallback);
+    OUTPUT:
+        RETVAL
+
+bool
+_xs_knows_type(type_name)
+    SV *type_name
+    PREINIT:
+        mop_builtin_tc_t tc;
+        bool maybe;
+    CODE:
+        RETVAL = SvOK(type_name) && mop_parse_builtin_tc(aTHX_ type_name, &tc, &maybe);
+    OUTPUT:
+        RETVAL
+
+MODULE = Moose::Meta::TypeConstraint   PACKAGE = Moose::Util::TypeConstraints::Builtins
+
+bool
+_xs_all_array(type_name, value)
+    SV *type_name
+    SV *value
+    CODE:
+        RETVAL = all_elements_pass(aTHX_ type_name, value, SVt_PVAV);
+    OUTPUT:
+        RETVAL
+
+bool
+_xs_all_hash(type_name, value)
+    SV *type_name
+    SV *value
+    CODE:
+        RETVAL = all_elements_pass(aTHX_ type_name, value, SVt_PVHV);
+    OUTPUT:
+        RETVAL
+
+MODULE = Moose::Meta::TypeConstraint   PACKAGE = Moose::Meta::TypeConstraint::Enum
+
+SV *
+_new_xs_check(values)
+    SV *values
+    PREINIT:
+        enum_table_t *table;
+        CV *check;
+    CODE:
+        if (!SvROK(values) || SvTYPE(SvRV(values)) != SVt_PVAV) {
+            croak("values must be an array reference");
+        }
+        table = new_enum_table(aTHX_ (AV *)SvRV(values));
+        check = newXS(NULL, mop_xs_enum_check, __FILE__);
+        CvXSUBANY(check).any_ptr = table;
+        sv_magicext((SV *)check, NULL, PERL_MAGIC_ext, &enum_check_vtbl, (char *)table, 0);
+        RETVAL = newRV_noinc((SV *)check);
+    OUTPUT:
+        RETVAL
+
+SV *
+_new_xs_interner(check)
+    SV *check
+    PREINIT:
+        enum_table_t *table;
+        CV *interner;
+    CODE:
+        if (!(table = enum_table_of(check))) {
+            croak("check must be an enum check made by _new_xs_check");
+        }
+        interner = newXS(NULL, mop_xs_enum_intern, __FILE__);
+        CvXSUBANY(interner).any_ptr = table;
+        /* which keeps the check, and so the table, alive */
+        sv_magicext((SV *)interner, SvRV(check), PERL_MAGIC_ext, NULL, NULL, 0);
+        RETVAL = newRV_noinc((SV *)interner);
+    OUTPUT:
+        RETVAL
+
+MODULE = Moose::Meta::TypeConstraint   PACKAGE = Moose::Meta::TypeConstraint::Class
+
+SV *
+_new_xs_check(class_name, fallback)
+    SV *class_name
+    SV *fallback
+    PREINIT:
+        isa_cache_t *cache;
+        CV *check;
+    CODE:
+        if (!SvOK(class_name) || !is_code_ref(fallback)) {
+            croak("_new_xs_check needs a class name and a code reference");
+        }
+        Newxz(cache, 1, isa_cache_t);
+        cache->class_name    = newSVsv(class_name);
+        cache->fallback      = newSVsv(fallback);
+        cache->universal_isa = get_cv("UNIVERSAL::isa", 0);
+        check = newXS(NULL, mop_xs_isa_check, __FILE__);
+        CvXSUBANY(check).any_ptr = cache;
+        sv_magicext((SV *)check, NULL, PERL_MAGIC_ext, &isa_check_vtbl, (char *)cache, 0);
+        RETVAL = newRV_noinc((SV *)check);
+    OUTPUT:
+        RETVAL
@@ -45,6 +45,20 @@ my %trustme = (
         qw( BUILDARGS
             is_dependent_on_superclasses ),
     ],
+    'Class::MOP::Instance::Array'                     => [
+        # documented in Class::MOP::Instance
+        qw( new
+            create_instance
+            get_slot_value
+            set_slot_value
+            deinitialize_slot
+            is_slot_initialized
+            weaken_slot_value
+            slot_value_is_weak
+            is_dependent_on_superclasses
+            inline_create_instance
+            inline_slot_access ),
+    ],
     'Class::MOP::Method::Generated'    => ['new'],
     'Class::MOP::MiniTrait'            => ['.+'],
     'Class::MOP::Mixin::AttributeCore' => ['.+'],